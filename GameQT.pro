@@ -11,22 +11,18 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+include(core.pri)
+include(gui.pri)
+include(assets.pri)
+
 SOURCES += \
-    car.cpp \
-    game.cpp \
     main.cpp \
     mainwindow.cpp
 
 HEADERS += \
-    car.h \
-    game.h \
-    mainwindow.h \
-    shared.h
+    mainwindow.h
 
 # Default rules for deployment.
 qnx: target.path = /tmp/$${TARGET}/bin
 else: unix:!android: target.path = /opt/$${TARGET}/bin
 !isEmpty(target.path): INSTALLS += target
-
-RESOURCES += \
-    resources.qrc
@@ -0,0 +1,15 @@
+# Host tool of the asset bake step in assets.pri. It is built and run
+# during the game build and is not shipped.
+
+QT = core gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle debug_and_release
+
+TEMPLATE = app
+TARGET = assetbake
+
+INCLUDEPATH += $$PWD/..
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,157 @@
+#include <QDir>
+#include <QFileInfo>
+#include <QImage>
+#include <QRect>
+#include <QString>
+#include <QStringList>
+#include <cstdio>
+#include <cstring>
+#include "car.h"
+#include "collisionmask.h"
+
+// Device pixel ratios the sprites are baked for; other ratios decode at startup
+static const int BAKE_SCALES[] = { 1, 2 };
+
+// Writes one scaled sprite as a byte array named pixels_<scale>
+static void writePixels(std::FILE* out, const QImage& image, int scale) {
+    std::fprintf(out, "alignas(16) static const uchar pixels_%d[] = {", scale);
+    int column = 0;
+    for (int y = 0; y < image.height(); ++y) {
+        const uchar* line = image.constScanLine(y);
+        for (int x = 0; x < image.width() * 4; ++x) {
+            std::fprintf(out, "%s0x%02x,", column == 0 ? "\n    " : " ", line[x]);
+            column = (column + 1) % 16;
+        }
+    }
+    std::fprintf(out, "\n};\n\n");
+}
+
+// Names of the sprites given to --masks, in SpriteId order
+static const char* const MASK_SPRITES[] = { "Player", "Traffic", "Crashed" };
+
+// Writes the collision masks of the car sprites as the definition of
+// CollisionMask::bySprite. Each sprite is scaled into the car box like the
+// drawn one, and pixels at least MASK_ALPHA_THRESHOLD opaque are solid.
+static int writeMasks(int count, char* paths[], const char* outputPath) {
+    const int spriteCount = sizeof(MASK_SPRITES) / sizeof(MASK_SPRITES[0]);
+    if (count != spriteCount) {
+        std::fprintf(stderr, "assetbake: --masks needs one image per sprite (%d)\n", spriteCount);
+        return 2;
+    }
+
+    std::FILE* out = std::fopen(outputPath, "w");
+    if (!out) {
+        std::fprintf(stderr, "assetbake: cannot write %s\n", outputPath);
+        return 1;
+    }
+    QStringList names;
+    for (int i = 0; i < count; ++i) {
+        names << QFileInfo(QString::fromLocal8Bit(paths[i])).fileName();
+    }
+    std::fprintf(out, "// Generated by assetbake --masks from %s; do not edit.\n\n",
+                 names.join(", ").toLocal8Bit().constData());
+    std::fprintf(out, "#include \"collisionmask.h\"\n\n");
+    std::fprintf(out, "const CollisionMask CollisionMask::bySprite[static_cast<int>(SpriteId::Count)] = {\n");
+
+    for (int i = 0; i < count; ++i) {
+        QImage image;
+        if (!image.load(QString::fromLocal8Bit(paths[i]))) {
+            std::fprintf(stderr, "assetbake: cannot read %s\n", paths[i]);
+            std::fclose(out);
+            return 1;
+        }
+        image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied)
+                    .scaled(QSize(CAR_SIZE_X, CAR_SIZE_Y), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+        quint64 rows[CAR_SIZE_Y][MASK_WORDS] = {};
+        QRect bounds;
+        for (int y = 0; y < image.height(); ++y) {
+            const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+            for (int x = 0; x < image.width(); ++x) {
+                if (qAlpha(line[x]) >= MASK_ALPHA_THRESHOLD) {
+                    rows[y][x / 64] |= quint64(1) << (x % 64);
+                    bounds |= QRect(x, y, 1, 1);
+                }
+            }
+        }
+
+        std::fprintf(out, "    // SpriteId::%s, %s scaled to %dx%d\n", MASK_SPRITES[i],
+                     names[i].toLocal8Bit().constData(), image.width(), image.height());
+        std::fprintf(out, "    { %d, %d, %d, %d, {\n", bounds.left(), bounds.top(), bounds.left() + bounds.width(),
+                     bounds.top() + bounds.height());
+        for (int y = 0; y < CAR_SIZE_Y; ++y) {
+            std::fprintf(out, "        {");
+            for (int word = 0; word < MASK_WORDS; ++word) {
+                std::fprintf(out, "%s 0x%016llxull", word == 0 ? "" : ",", static_cast<unsigned long long>(rows[y][word]));
+            }
+            std::fprintf(out, " },\n");
+        }
+        std::fprintf(out, "    } },\n");
+    }
+    std::fprintf(out, "};\n");
+
+    bool ok = std::ferror(out) == 0;
+    ok = std::fclose(out) == 0 && ok;
+    return ok ? 0 : 1;
+}
+
+// Build step of assets.pri: scales a sprite to fit the car size at each
+// baked device pixel ratio, the same way SpriteCache does at runtime, and
+// writes the premultiplied ARGB32 pixels as a C++ source that registers
+// them with SpriteCache before main(). Pixels are in host byte order, so
+// the tool must run on a machine with the target's endianness.
+// With --masks it writes the collision masks instead; see writeMasks().
+// Usage: assetbake <input image> <output.cpp> <resource path>
+//        assetbake --masks <output.cpp> <player image> <traffic image> <crashed image>
+int main(int argc, char *argv[])
+{
+    if (argc >= 3 && std::strcmp(argv[1], "--masks") == 0) {
+        return writeMasks(argc - 3, argv + 3, argv[2]);
+    }
+    if (argc != 4) {
+        std::fprintf(stderr, "usage: assetbake <input image> <output.cpp> <resource path>\n"
+                             "       assetbake --masks <output.cpp> <player image> <traffic image> <crashed image>\n");
+        return 2;
+    }
+
+    QImage source;
+    if (!source.load(QString::fromLocal8Bit(argv[1]))) {
+        std::fprintf(stderr, "assetbake: cannot read %s\n", argv[1]);
+        return 1;
+    }
+    source = source.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    QString outputPath = QString::fromLocal8Bit(argv[2]);
+    QDir().mkpath(QFileInfo(outputPath).path());
+    std::FILE* out = std::fopen(argv[2], "w");
+    if (!out) {
+        std::fprintf(stderr, "assetbake: cannot write %s\n", argv[2]);
+        return 1;
+    }
+
+    std::fprintf(out, "// Generated by assetbake from %s; do not edit.\n\n",
+                 QFileInfo(QString::fromLocal8Bit(argv[1])).fileName().toLocal8Bit().constData());
+    std::fprintf(out, "#include \"spritecache.h\"\n\n");
+
+    QSize sizes[sizeof(BAKE_SCALES) / sizeof(BAKE_SCALES[0])];
+    int count = 0;
+    for (int scale : BAKE_SCALES) {
+        QImage image = source.scaled(QSize(CAR_SIZE_X, CAR_SIZE_Y) * scale, Qt::KeepAspectRatio,
+                                     Qt::SmoothTransformation);
+        writePixels(out, image, scale);
+        sizes[count++] = image.size();
+    }
+
+    std::fprintf(out, "[[maybe_unused]] static const bool registered[] = {\n");
+    count = 0;
+    for (int scale : BAKE_SCALES) {
+        std::fprintf(out, "    SpriteCache::registerBaked(\"%s\", %d, %d, %d, %d, pixels_%d),\n", argv[3],
+                     CAR_SIZE_X * scale, CAR_SIZE_Y * scale, sizes[count].width(), sizes[count].height(), scale);
+        ++count;
+    }
+    std::fprintf(out, "};\n");
+
+    bool ok = std::ferror(out) == 0;
+    ok = std::fclose(out) == 0 && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,40 @@
+# Build-time asset preprocessing for the game. The car sprites are scaled
+# to the car size at 1x and 2x device pixel ratio by the assetbake tool and
+# compiled in as premultiplied ARGB32 pixels, so startup neither decodes
+# nor scales them. Builds without this file (the benchmarks) fall back to
+# decoding the PNGs from resources.qrc.
+
+ASSET_BAKE_DIR = $$OUT_PWD/assetbake
+ASSET_BAKE = $$ASSET_BAKE_DIR/assetbake
+win32: ASSET_BAKE = $${ASSET_BAKE}.exe
+
+# The tool is built with the same qmake before the first sprite is baked
+assetbake_tool.target = $$ASSET_BAKE
+assetbake_tool.depends = $$PWD/assetbake/main.cpp $$PWD/assetbake/assetbake.pro $$PWD/car.h $$PWD/collisionmask.h
+assetbake_tool.commands = \
+    $$sprintf($$QMAKE_MKDIR_CMD, $$shell_path($$ASSET_BAKE_DIR)) && \
+    cd $$shell_path($$ASSET_BAKE_DIR) && \
+    $$shell_quote($$QMAKE_QMAKE) $$shell_quote($$PWD/assetbake/assetbake.pro) && \
+    $(MAKE)
+QMAKE_EXTRA_TARGETS += assetbake_tool
+
+BAKED_SPRITES = \
+    $$PWD/img/car_image.png \
+    $$PWD/img/crashed_car.png \
+    $$PWD/img/secondary_car2.png
+
+spritebake.name = bake ${QMAKE_FILE_IN}
+spritebake.input = BAKED_SPRITES
+spritebake.output = $$OUT_PWD/baked/baked_${QMAKE_FILE_BASE}.cpp
+spritebake.commands = $$shell_quote($$ASSET_BAKE) ${QMAKE_FILE_IN} ${QMAKE_FILE_OUT} :/img/${QMAKE_FILE_BASE}${QMAKE_FILE_EXT}
+spritebake.depends = $$ASSET_BAKE
+spritebake.variable_out = SOURCES
+QMAKE_EXTRA_COMPILERS += spritebake
+
+# The collision masks are checked in as spritemasks.cpp, so the QtCore-only
+# game core does not depend on the image plugins. After changing a car
+# sprite, regenerate them with: make collision_masks
+collision_masks.commands = $$shell_quote($$ASSET_BAKE) --masks $$shell_quote($$PWD/spritemasks.cpp) \
+    $$PWD/img/car_image.png $$PWD/img/secondary_car2.png $$PWD/img/crashed_car.png
+collision_masks.depends = $$ASSET_BAKE
+QMAKE_EXTRA_TARGETS += collision_masks
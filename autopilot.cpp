@@ -0,0 +1,128 @@
+#include "autopilot.h"
+#include <QSemaphore>
+#include "gamelog.h"
+
+// ===========================
+// Autopilot Class Implementation
+// ===========================
+
+// First moves in order of preference when they survive equally long
+static const int firstSteers[3] = {0, -1, 1};
+
+// Constructor starts a pool with one thread per first move
+Autopilot::Autopilot() : lastNodes(0), timedOut(false) {
+    pool.setMaxThreadCount(3);
+}
+
+// Returns true on ticks where the autopilot chooses a new move
+bool Autopilot::isDecisionTick(quint32 tick) {
+    return tick % AUTOPILOT_DECISION_TICKS == 0;
+}
+
+// Searches the three first moves in parallel and returns the best one
+int Autopilot::decide(const Simulation& simulation, qint64 budgetUs) {
+    SimSnapshot root;
+    if (simulation.isCrashed() || !simulation.save(root)) {
+        return 0;
+    }
+
+    const qint64 deadline = PerfStats::now() + budgetUs * 1000;
+    QSemaphore finished;
+    for (int i = 0; i < 3; ++i) {
+        searches[i].deadline = deadline;
+        pool.start([this, i, &root, &finished]() {
+            run(searches[i], root, firstSteers[i]);
+            finished.release();
+        });
+    }
+    finished.acquire(3);
+
+    int best = 0;
+    lastNodes = 0;
+    timedOut = false;
+    for (int i = 0; i < 3; ++i) {
+        lastNodes += searches[i].nodes;
+        timedOut = timedOut || searches[i].timedOut;
+        if (searches[i].survived > searches[best].survived) {
+            best = i;
+        }
+    }
+    LOG_DEBUG(Simulation, "Autopilot chose %.0f after %.0f nodes (survives %.0f ticks).",
+              firstSteers[best], lastNodes, searches[best].survived);
+    return firstSteers[best];
+}
+
+// Explores everything that follows one first move from the root state
+void Autopilot::run(Search& search, const SimSnapshot& root, int firstSteer) {
+    search.nodes = 0;
+    search.timedOut = false;
+    search.survived = -1;
+
+    // A move into the wall is the same as staying; leave it to the stay search
+    const int lane = root.playerLane + firstSteer;
+    if (firstSteer != 0 && (lane < 0 || lane >= root.laneCount)) {
+        return;
+    }
+
+    search.stack[0] = root;
+    search.simulation.restore(root);
+    search.survived = explore(search, 0, firstSteer, 0);
+}
+
+// Applies steer at a decision point, plays until the next one and recurses.
+// Returns the most ticks any continuation survives, capped at the horizon.
+int Autopilot::explore(Search& search, int depth, int steer, int ticksSoFar) {
+    ++search.nodes;
+    Simulation& simulation = search.simulation;
+
+    // Steering takes effect on the first tick; the rest of the interval drives straight
+    SimInput input;
+    input.steer = steer;
+    int ticks = ticksSoFar;
+    for (int i = 0; i < AUTOPILOT_DECISION_TICKS && ticks < AUTOPILOT_HORIZON_TICKS; ++i) {
+        simulation.step(SIM_STEP_MS, input);
+        input.steer = 0;
+        if (simulation.isCrashed()) {
+            return ticks;
+        }
+        ++ticks;
+    }
+    if (ticks >= AUTOPILOT_HORIZON_TICKS) {
+        return ticks;
+    }
+    if (PerfStats::now() > search.deadline) {
+        search.timedOut = true;
+        return ticks;
+    }
+
+    // Try each next move from the same state, best-first order as above
+    simulation.save(search.stack[depth + 1]);
+    const int lane = simulation.getPlayerLane();
+    const int laneCount = simulation.getTraffic().getLaneCount();
+    int best = ticks;
+    bool fresh = true; // The simulation still holds the saved state
+    for (int next : firstSteers) {
+        if (next != 0 && (lane + next < 0 || lane + next >= laneCount)) {
+            continue;
+        }
+        if (!fresh) {
+            simulation.restore(search.stack[depth + 1]);
+        }
+        fresh = false;
+        best = qMax(best, explore(search, depth + 1, next, ticks));
+        if (best >= AUTOPILOT_HORIZON_TICKS || search.timedOut) {
+            break;
+        }
+    }
+    return best;
+}
+
+// Returns the number of decision points the last search visited
+qint64 Autopilot::getLastNodes() const {
+    return lastNodes;
+}
+
+// Returns true if the last search ran out of time
+bool Autopilot::lastTimedOut() const {
+    return timedOut;
+}
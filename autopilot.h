@@ -0,0 +1,50 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include <QThreadPool>
+#include <QtGlobal>
+#include "simulation.h"
+
+#define AUTOPILOT_DECISION_TICKS 5 // Steering is reconsidered every 50 ms of game time
+#define AUTOPILOT_HORIZON_TICKS 200 // Searches 2 s ahead; traffic crosses the screen faster than that from level 6
+#define AUTOPILOT_BUDGET_US 3000 // Wall time allowed per decision, well inside a 16 ms frame
+#define AUTOPILOT_MAX_DEPTH (AUTOPILOT_HORIZON_TICKS / AUTOPILOT_DECISION_TICKS + 1)
+
+// Chooses left, right or stay by searching the game's future from a
+// snapshot. Each of the three first moves is explored on its own pool
+// thread with its own Simulation. The search is depth-first over decision
+// points every AUTOPILOT_DECISION_TICKS ticks, restoring a snapshot to try
+// the next branch. A branch ends when it crashes or reaches the horizon,
+// and a move that survives the whole horizon stops its search early. The
+// move that survives longest wins; ties prefer staying, so the car does
+// not weave. When the time budget runs out, each search returns the best it
+// has found so far.
+class Autopilot
+{
+public:
+    Autopilot();
+    int decide(const Simulation& simulation, qint64 budgetUs = AUTOPILOT_BUDGET_US); // Returns -1, 0 or +1
+    static bool isDecisionTick(quint32 tick);
+    qint64 getLastNodes() const; // Decision points visited by the last decide()
+    bool lastTimedOut() const;
+
+private:
+    struct Search {
+        Simulation simulation;
+        SimSnapshot stack[AUTOPILOT_MAX_DEPTH];
+        qint64 deadline;
+        qint64 nodes;
+        bool timedOut;
+        int survived; // Best number of ticks survived for the first move
+    };
+
+    void run(Search& search, const SimSnapshot& root, int firstSteer);
+    int explore(Search& search, int depth, int steer, int ticksSoFar);
+
+    QThreadPool pool;
+    Search searches[3]; // One per first move: stay, left, right
+    qint64 lastNodes;
+    bool timedOut;
+};
+
+#endif // AUTOPILOT_H
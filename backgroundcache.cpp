@@ -0,0 +1,200 @@
+#include "backgroundcache.h"
+#include <QImage>
+#include <QImageReader>
+#include <QPainter>
+#include <QDebug>
+#include <QThread>
+#include <algorithm>
+#include <memory>
+#include "gamelog.h"
+#include "trace.h"
+
+// ===========================
+// BackgroundCache Class Implementation
+// ===========================
+
+// Constructor creates an empty cache; call load() before drawing
+BackgroundCache::BackgroundCache()
+    : duration(0),
+    loader(nullptr),
+    loadRatio(1.0),
+    loaderDone(true),
+    cancelLoad(false)
+{
+}
+
+// Destructor stops a load that is still running
+BackgroundCache::~BackgroundCache() {
+    stopLoader();
+}
+
+// Decodes the first frame of an animation and starts decoding the others
+// on a worker thread. Every kept frame is stored scaled to size.
+bool BackgroundCache::load(const QString &path, const QSize &size, qreal devicePixelRatio) {
+    stopLoader();
+    frames.clear();
+    frameEnds.clear();
+    duration = 0;
+
+    auto reader = std::make_unique<QImageReader>(path);
+    if (!reader->canRead()) {
+        qWarning() << "Failed to open background animation" << path;
+        return false;
+    }
+
+    // Keep every n-th frame if the whole animation does not fit the budget
+    const QSize pixelSize = size * devicePixelRatio;
+    const qint64 frameBytes = qint64(pixelSize.width()) * pixelSize.height() * 4;
+    const qint64 budget = qint64(BACKGROUND_CACHE_BUDGET_MB) * 1024 * 1024;
+    const int imageCount = qMax(1, reader->imageCount());
+    const int stride = qMax<qint64>(1, (imageCount * frameBytes + budget - 1) / budget);
+
+    // The first frame is all the first paint needs
+    DecodedFrame first;
+    if (!decodeNext(*reader, 0, stride, pixelSize, first)) {
+        qWarning() << "Failed to decode background animation" << path;
+        return false;
+    }
+    addFrame(first, devicePixelRatio);
+
+    loadRatio = devicePixelRatio;
+    loaderDone = false;
+    cancelLoad = false;
+    loader = QThread::create([this, reader = std::move(reader), stride, pixelSize]() {
+        Trace::setThreadName("background loader");
+        DecodedFrame frame;
+        for (int index = 1; decodeNext(*reader, index, stride, pixelSize, frame); ++index) {
+            QMutexLocker locker(&mutex);
+            if (cancelLoad) {
+                break;
+            }
+            decoded.append(frame);
+        }
+        QMutexLocker locker(&mutex);
+        loaderDone = true;
+    });
+    loader->start();
+    return true;
+}
+
+// Reads the next source frame. Kept frames get the white underlay and the
+// scaling baked into one opaque image; skipped frames only report their delay.
+bool BackgroundCache::decodeNext(QImageReader &reader, int index, int stride, const QSize &pixelSize,
+                                 DecodedFrame &frame) {
+    TRACE_SCOPE("assets", "decode background frame");
+    if (!reader.canRead()) {
+        return false;
+    }
+    QImage source = reader.read();
+    if (source.isNull()) {
+        return false;
+    }
+    frame.delay = reader.nextImageDelay();
+    if (frame.delay <= 0) {
+        frame.delay = 100; // Same default QMovie uses for frames without a delay
+    }
+
+    frame.image = QImage();
+    if (index % stride == 0) {
+        frame.image = QImage(pixelSize, QImage::Format_RGB32);
+        frame.image.fill(Qt::white);
+        QPainter painter(&frame.image);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        painter.drawImage(QRect(QPoint(0, 0), pixelSize), source);
+    }
+    return true;
+}
+
+// Appends a kept frame, or extends the last kept frame by a skipped one
+void BackgroundCache::addFrame(const DecodedFrame &frame, qreal devicePixelRatio) {
+    if (frame.image.isNull()) {
+        frameEnds.last() += frame.delay;
+    } else {
+        QPixmap pixmap = QPixmap::fromImage(frame.image);
+        pixmap.setDevicePixelRatio(devicePixelRatio);
+        frames.append(pixmap);
+        frameEnds.append(duration + frame.delay);
+    }
+    duration += frame.delay;
+}
+
+// Returns true while the worker is still decoding frames
+bool BackgroundCache::isLoading() const {
+    return loader != nullptr;
+}
+
+// Adds the frames the worker has decoded so far; pixmaps are GUI-thread only,
+// so this must run on the GUI thread. Returns true if frames were added.
+bool BackgroundCache::collectLoadedFrames() {
+    if (!loader) {
+        return false;
+    }
+    TRACE_SCOPE("assets", "collect background frames");
+    QVector<DecodedFrame> ready;
+    bool done;
+    {
+        QMutexLocker locker(&mutex);
+        ready.swap(decoded);
+        done = loaderDone;
+    }
+    for (const DecodedFrame& frame : ready) {
+        addFrame(frame, loadRatio);
+    }
+    if (done) {
+        stopLoader();
+        LOG_INFO(Game, "Background cached: %.0f frames, loop %.0f ms", frames.size(), duration);
+    }
+    return !ready.isEmpty();
+}
+
+// Cancels the worker and waits for it; frames it did not hand over are dropped
+void BackgroundCache::stopLoader() {
+    if (!loader) {
+        return;
+    }
+    {
+        QMutexLocker locker(&mutex);
+        cancelLoad = true;
+    }
+    loader->wait();
+    delete loader;
+    loader = nullptr;
+    decoded.clear();
+}
+
+// Returns true if at least one frame was decoded
+bool BackgroundCache::isValid() const {
+    return !frames.isEmpty();
+}
+
+// Returns the number of cached frames
+int BackgroundCache::frameCount() const {
+    return frames.size();
+}
+
+// Returns the length of one animation loop in milliseconds
+qint64 BackgroundCache::getDuration() const {
+    return duration;
+}
+
+// Returns the index of the frame shown at the given animation time, or -1 if nothing is loaded
+int BackgroundCache::frameIndexAt(qint64 animationTime) const {
+    if (frames.isEmpty()) {
+        return -1;
+    }
+    // While frames are still decoding, hold the last one instead of looping early
+    qint64 time = loader ? qMin(animationTime, duration - 1) : animationTime % duration;
+    int index = std::upper_bound(frameEnds.constBegin(), frameEnds.constEnd(), time) - frameEnds.constBegin();
+    return qMin(index, static_cast<int>(frames.size()) - 1);
+}
+
+// Returns the frame shown at the given animation time, looping as needed
+const QPixmap& BackgroundCache::frameAt(qint64 animationTime) const {
+    int index = frameIndexAt(animationTime);
+    return index < 0 ? emptyFrame : frames[index];
+}
+
+// Returns the cached frame with the given index
+const QPixmap& BackgroundCache::frame(int index) const {
+    return frames[index];
+}
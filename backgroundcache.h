@@ -0,0 +1,65 @@
+#ifndef BACKGROUNDCACHE_H
+#define BACKGROUNDCACHE_H
+
+#include <QImage>
+#include <QMutex>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+class QImageReader;
+class QThread;
+
+#define BACKGROUND_CACHE_BUDGET_MB 160 // Upper bound for the decoded, pre-scaled frames
+
+// Animated background decoded once and kept pre-scaled to the window size.
+// Frames are selected by an animation time supplied by the caller, so the
+// animation follows the simulation instead of running on its own timer.
+// If all frames would exceed the memory budget, only every n-th frame is
+// kept and each kept frame covers the delays of the skipped ones.
+// load() decodes the first frame and returns; a worker thread decodes the
+// rest, and collectLoadedFrames() adds them on the GUI thread. Until the
+// whole loop is known, times past the decoded frames show the last one.
+class BackgroundCache
+{
+public:
+    BackgroundCache();
+    ~BackgroundCache();
+    bool load(const QString& path, const QSize& size, qreal devicePixelRatio);
+    bool isLoading() const;
+    bool collectLoadedFrames();
+    bool isValid() const;
+    int frameCount() const;
+    qint64 getDuration() const;
+    int frameIndexAt(qint64 animationTime) const;
+    const QPixmap& frameAt(qint64 animationTime) const;
+    const QPixmap& frame(int index) const;
+
+private:
+    // A decoded source frame; image is null for frames skipped by the budget
+    struct DecodedFrame {
+        QImage image;
+        int delay;
+    };
+
+    static bool decodeNext(QImageReader& reader, int index, int stride, const QSize& pixelSize,
+                           DecodedFrame& frame);
+    void addFrame(const DecodedFrame& frame, qreal devicePixelRatio);
+    void stopLoader();
+
+    QVector<QPixmap> frames;
+    QVector<qint64> frameEnds; // End of each kept frame within the loop, in milliseconds
+    qint64 duration; // Length of one animation loop in milliseconds
+    QPixmap emptyFrame;
+
+    // Background decoding of the frames after the first
+    QThread* loader;
+    qreal loadRatio; // Device pixel ratio of the frames being decoded
+    mutable QMutex mutex;
+    QVector<DecodedFrame> decoded; // Frames the loader finished, guarded by mutex
+    bool loaderDone; // Loader decoded its last frame, guarded by mutex
+    bool cancelLoad; // Asks the loader to stop early, guarded by mutex
+};
+
+#endif // BACKGROUNDCACHE_H
@@ -0,0 +1,326 @@
+#include "batchenv.h"
+#include <QDebug>
+#include <QSemaphore>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+#include "spawnscheduler.h"
+#include "simulation.h"
+#include "collisionmask.h"
+
+// ===========================
+// BatchEnv Class Implementation
+// ===========================
+
+// Constructor sets up an empty batch; call reset() with one seed per game.
+// Asking for more than BATCH_MAX_TRAFFIC cars logs a warning, and the batch
+// then runs BATCH_MAX_TRAFFIC cars.
+BatchEnv::BatchEnv(int laneCount, int trafficCount, int threadCount)
+    : laneCount(qBound(1, laneCount, MAX_LANE_COUNT)),
+    trafficCount(qBound(0, trafficCount, BATCH_MAX_TRAFFIC)),
+    count(0),
+    band(2 * CAR_SIZE_Y + SPAWN_PADDING + SPAWN_MARGIN)
+{
+    if (trafficCount > BATCH_MAX_TRAFFIC) {
+        qWarning() << "BatchEnv supports at most" << BATCH_MAX_TRAFFIC << "cars per game, not" << trafficCount;
+    }
+
+    for (int lane = 0; lane < this->laneCount; ++lane) {
+        laneX[lane] = Traffic::laneToX(lane, this->laneCount);
+    }
+
+    // The calling thread runs one chunk, so the pool needs one thread fewer
+    if (threadCount <= 0) {
+        threadCount = QThread::idealThreadCount();
+    }
+    pool.setMaxThreadCount(qMax(1, threadCount - 1));
+}
+
+// Starts one game per seed, replacing the previous batch
+void BatchEnv::reset(const std::vector<quint64>& seeds) {
+    count = static_cast<int>(seeds.size());
+    playerLane.assign(count, 0);
+    playerX.assign(count, 0.0f);
+    level.assign(count, 2);
+    elapsed.assign(count, 0);
+    tick.assign(count, 0);
+    done.assign(count, 0);
+    rng.assign(count, Rng());
+    distance.assign(count, 0.0f);
+    wrapped.assign(count, 0);
+    hit.assign(count, 0);
+    trafficY.assign(size_t(trafficCount) * count, 0.0f);
+
+    for (int game = 0; game < count; ++game) {
+        resetGame(game, seeds[game]);
+    }
+}
+
+// Restarts one game with a new seed, as Simulation::reset(seed) does
+void BatchEnv::resetGame(int game, quint64 seed) {
+    rng[game].reseed(seed);
+    playerLane[game] = laneCount / 2;
+    playerX[game] = laneX[playerLane[game]];
+    level[game] = 2;
+    elapsed[game] = 0;
+    tick[game] = 0;
+    done[game] = 0;
+
+    // Cars enter one at a time, each placed against the ones already placed
+    for (int car = 0; car < trafficCount; ++car) {
+        trafficY[size_t(car) * count + game] = place(game, car, car + 1);
+    }
+}
+
+// Advances every game by one SIM_STEP_MS tick, split across the thread pool
+void BatchEnv::step(const std::vector<qint8>& actions) {
+    if (count == 0) {
+        return;
+    }
+    const qint8* input = actions.data();
+
+    // Chunks are multiples of BATCH_MIN_CHUNK so threads never share a cache line
+    const int threads = pool.maxThreadCount() + 1;
+    int chunk = (count + threads - 1) / threads;
+    chunk = (chunk + BATCH_MIN_CHUNK - 1) / BATCH_MIN_CHUNK * BATCH_MIN_CHUNK;
+
+    QSemaphore finished;
+    int queued = 0;
+    for (int begin = chunk; begin < count; begin += chunk) {
+        const int end = std::min(count, begin + chunk);
+        pool.start([this, begin, end, input, &finished]() {
+            stepRange(begin, end, input);
+            finished.release();
+        });
+        ++queued;
+    }
+    stepRange(0, std::min(count, chunk), input);
+    finished.acquire(queued);
+}
+
+// Steps the games in [begin, end): steering, movement, respawns and collisions
+void BatchEnv::stepRange(int begin, int end, const qint8* actions) {
+    const float stepSeconds = SIM_STEP_MS / 1000.0f;
+    const float mainY = WINDOWS_SIZE_Y - CAR_SIZE_Y - 20;
+
+    // Steering, level and the distance each game's road moves; finished games stay frozen
+    for (int game = begin; game < end; ++game) {
+        const bool running = !done[game];
+        const int steer = (actions[game] > 0) - (actions[game] < 0);
+        const int lane = playerLane[game] + steer;
+        if (running && steer != 0 && lane >= 0 && lane < laneCount) {
+            playerLane[game] = lane;
+            playerX[game] = laneX[lane];
+        }
+        tick[game] += running;
+        level[game] = running ? 3 + elapsed[game] / 5000 : level[game]; // Same as 3 + 2 * elapsed / 10000
+        distance[game] = running ? level[game] * SPEED_PER_LEVEL * stepSeconds : 0.0f;
+        wrapped[game] = 0;
+        hit[game] = 0;
+    }
+
+    // Flag games where a car's path over the step crosses the bounds of the
+    // player's collision mask, branch-free, before anything moves. The
+    // offsets are the ones CollisionMask::sweep accepts.
+    const CollisionMask& playerMask = CollisionMask::forSprite(SpriteId::Player);
+    const CollisionMask& carMask = CollisionMask::forSprite(SpriteId::Traffic);
+    const float nearLeft = playerMask.left - carMask.right - 1.0f;
+    const float nearRight = playerMask.right - carMask.left + 1.0f;
+    const float nearTop = playerMask.top - carMask.bottom - 1.0f;
+    const float nearBottom = playerMask.bottom - carMask.top + 1.0f;
+    for (int car = 0; car < trafficCount; ++car) {
+        const float* __restrict ys = trafficY.data() + size_t(car) * count;
+        const float* __restrict moved = distance.data();
+        const float* __restrict xs = playerX.data();
+        quint8* __restrict hits = hit.data();
+        const float carX = laneX[car % laneCount];
+        for (int game = begin; game < end; ++game) {
+            const float offsetX = carX - xs[game];
+            const float from = ys[game];
+            const float to = from + moved[game];
+            hits[game] |= (nearLeft < offsetX) & (offsetX < nearRight) & (nearTop < to - mainY) &
+                          (from - mainY < nearBottom);
+        }
+    }
+
+    // Flagged games are rare, so their collision masks take the scalar path
+    for (int game = begin; game < end; ++game) {
+        if (hit[game]) {
+            hit[game] = !done[game] && sweepHit(game);
+        }
+    }
+
+    // Move each car column and flag games where a car left the screen
+    for (int car = 0; car < trafficCount; ++car) {
+        float* __restrict ys = trafficY.data() + size_t(car) * count;
+        const float* __restrict moved = distance.data();
+        quint8* __restrict flags = wrapped.data();
+        for (int game = begin; game < end; ++game) {
+            ys[game] += moved[game];
+            flags[game] |= ys[game] > WINDOWS_SIZE_Y;
+        }
+    }
+
+    // Respawns are rare, so they take the scalar path per game; like
+    // Simulation, a crashed game keeps the cars where they hit
+    for (int game = begin; game < end; ++game) {
+        if (wrapped[game] && !done[game] && !hit[game]) {
+            respawnWrapped(game);
+        }
+    }
+
+    // A crash ends the game; otherwise the survived time grows
+    for (int game = begin; game < end; ++game) {
+        const quint8 running = !done[game];
+        elapsed[game] += (running & !hit[game]) * SIM_STEP_MS;
+        done[game] |= hit[game];
+    }
+}
+
+// Returns true if the player of one game touches a car during the current
+// step, with the same swept mask test as Simulation::checkCollision. Called
+// before the cars move, so trafficY still holds their previous Y.
+bool BatchEnv::sweepHit(int game) const {
+    const CollisionMask& playerMask = CollisionMask::forSprite(SpriteId::Player);
+    const CollisionMask& carMask = CollisionMask::forSprite(SpriteId::Traffic);
+    const float mainY = WINDOWS_SIZE_Y - CAR_SIZE_Y - 20;
+    const float x = playerX[game];
+    for (int car = 0; car < trafficCount; ++car) {
+        const float from = trafficY[size_t(car) * count + game];
+        if (playerMask.sweep(x, x, mainY, carMask, laneX[car % laneCount], from, from + distance[game]) >= 0.0f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Respawns the cars of one game that passed the bottom edge, in the order
+// Simulation uses: lane by lane, lowest car first within a lane
+void BatchEnv::respawnWrapped(int game) {
+    int order[BATCH_MAX_TRAFFIC];
+    int wrappedCount = 0;
+    for (int car = 0; car < trafficCount; ++car) {
+        if (trafficY[size_t(car) * count + game] > WINDOWS_SIZE_Y) {
+            order[wrappedCount++] = car;
+        }
+    }
+    std::sort(order, order + wrappedCount, [this, game](int a, int b) {
+        if (a % laneCount != b % laneCount) {
+            return a % laneCount < b % laneCount;
+        }
+        return trafficY[size_t(a) * count + game] > trafficY[size_t(b) * count + game];
+    });
+    for (int i = 0; i < wrappedCount; ++i) {
+        trafficY[size_t(order[i]) * count + game] = place(game, order[i], trafficCount);
+    }
+}
+
+// Returns the re-entry Y of a car, with the same rule as SpawnScheduler::place.
+// Only cars below placedCount exist yet; that matters while a game starts.
+float BatchEnv::place(int game, int car, int placedCount) {
+    const int lane = car % laneCount;
+
+    // Top car of each lane, ignoring the car being placed
+    float laneTop[MAX_LANE_COUNT];
+    bool laneUsed[MAX_LANE_COUNT] = {};
+    for (int other = 0; other < placedCount; ++other) {
+        if (other == car) {
+            continue;
+        }
+        const int otherLane = other % laneCount;
+        const float y = trafficY[size_t(other) * count + game];
+        if (!laneUsed[otherLane] || y < laneTop[otherLane]) {
+            laneTop[otherLane] = y;
+            laneUsed[otherLane] = true;
+        }
+    }
+
+    // Above the screen and above the other cars in the lane, with random spacing
+    float y = -CAR_SIZE_Y;
+    if (laneUsed[lane]) {
+        y = std::min(y, laneTop[lane] - LANE_MIN_GAP);
+    }
+    y -= rng[game].bounded(SPAWN_JITTER);
+
+    if (laneCount < 2) {
+        return y;
+    }
+
+    // Keep y if some other lane is free around it
+    float lowestTop = -1e30f;
+    for (int otherLane = 0; otherLane < laneCount; ++otherLane) {
+        if (otherLane == lane) {
+            continue;
+        }
+        bool near = false;
+        for (int other = otherLane; other < placedCount && !near; other += laneCount) {
+            const float otherY = trafficY[size_t(other) * count + game];
+            near = other != car && otherY > y - band && otherY < y + band;
+        }
+        if (!near) {
+            return y;
+        }
+        lowestTop = std::max(lowestTop, laneTop[otherLane]);
+    }
+    return lowestTop - band;
+}
+
+// Returns the number of games
+int BatchEnv::size() const {
+    return count;
+}
+
+// Returns the number of lanes of every game
+int BatchEnv::getLaneCount() const {
+    return laneCount;
+}
+
+// Returns the number of traffic cars of every game
+int BatchEnv::getTrafficCount() const {
+    return trafficCount;
+}
+
+// Returns the number of threads step() uses, including the caller
+int BatchEnv::getThreadCount() const {
+    return pool.maxThreadCount() + 1;
+}
+
+// Returns true once a game has crashed
+bool BatchEnv::isDone(int game) const {
+    return done[game];
+}
+
+// Returns the lane the player of a game is in
+int BatchEnv::getPlayerLane(int game) const {
+    return playerLane[game];
+}
+
+// Returns the difficulty level of a game's last step
+int BatchEnv::getLevel(int game) const {
+    return level[game];
+}
+
+// Returns the simulated time a game has survived in milliseconds
+qint32 BatchEnv::getElapsed(int game) const {
+    return elapsed[game];
+}
+
+// Returns the number of steps a game has taken, including its crash step
+quint32 BatchEnv::getTick(int game) const {
+    return tick[game];
+}
+
+// Returns the Y of one traffic car of a game
+float BatchEnv::getTrafficY(int game, int car) const {
+    return trafficY[size_t(car) * count + game];
+}
+
+// Returns the done flags of all games
+const quint8* BatchEnv::doneData() const {
+    return done.data();
+}
+
+// Returns the Y column of one traffic car across all games
+const float* BatchEnv::trafficYData(int car) const {
+    return trafficY.data() + size_t(car) * count;
+}
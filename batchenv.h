@@ -0,0 +1,78 @@
+#ifndef BATCHENV_H
+#define BATCHENV_H
+
+#include <QThreadPool>
+#include <QtGlobal>
+#include <vector>
+#include "shared.h"
+#include "traffic.h"
+#include "rng.h"
+
+#define BATCH_MAX_TRAFFIC 64 // Cars per game; respawn ordering uses a fixed-size scratch list
+#define BATCH_MIN_CHUNK 256 // Fewest games handed to one thread, a multiple of the cache line
+
+// Thousands of independent games stepped together for automated players.
+// It follows the same rules as Simulation, including the spawn placement,
+// collision masks and level curve, and consumes the same random numbers,
+// so a game started with seed s plays exactly like Simulation(lanes, cars, s).
+//
+// State is stored as structure of arrays. Traffic is car-major: the Y values
+// of car k in every game are contiguous, so moving cars and finding games
+// where a car comes near the player are flat loops over games that the
+// compiler vectorizes. Only those games take the scalar collision mask
+// test, and only games where a car left the screen the scalar respawn path.
+// step() splits the games into chunks across a thread pool, and the calling
+// thread works one chunk too.
+class BatchEnv
+{
+public:
+    explicit BatchEnv(int laneCount = DEFAULT_LANE_COUNT, int trafficCount = DEFAULT_TRAFFIC_COUNT,
+                      int threadCount = 0); // trafficCount at most BATCH_MAX_TRAFFIC; 0 threads uses every core
+    void reset(const std::vector<quint64>& seeds); // One game per seed
+    void resetGame(int game, quint64 seed);
+    void step(const std::vector<qint8>& actions); // -1, 0 or +1 per game; finished games ignore it
+
+    int size() const;
+    int getLaneCount() const;
+    int getTrafficCount() const;
+    int getThreadCount() const;
+    bool isDone(int game) const;
+    int getPlayerLane(int game) const;
+    int getLevel(int game) const;
+    qint32 getElapsed(int game) const; // Milliseconds survived
+    quint32 getTick(int game) const;
+    float getTrafficY(int game, int car) const;
+    const quint8* doneData() const; // One flag per game
+    const float* trafficYData(int car) const; // Y of one car in every game
+
+private:
+    void stepRange(int begin, int end, const qint8* actions);
+    bool sweepHit(int game) const;
+    void respawnWrapped(int game);
+    float place(int game, int car, int placedCount);
+
+    int laneCount;
+    int trafficCount;
+    int count; // Number of games
+    float band; // Same wall band as SpawnScheduler
+    int laneX[MAX_LANE_COUNT];
+
+    // One entry per game
+    std::vector<qint32> playerLane;
+    std::vector<float> playerX;
+    std::vector<qint32> level;
+    std::vector<qint32> elapsed;
+    std::vector<quint32> tick;
+    std::vector<quint8> done;
+    std::vector<Rng> rng;
+    std::vector<float> distance; // Scratch: road distance of the current step
+    std::vector<quint8> wrapped; // Scratch: a car left the screen this step
+    std::vector<quint8> hit; // Scratch: the player touches a car this step
+
+    // trafficCount * count entries, car-major
+    std::vector<float> trafficY;
+
+    QThreadPool pool;
+};
+
+#endif // BATCHENV_H
@@ -0,0 +1,82 @@
+#include "alloccounter.h"
+#include <cstdlib>
+#include <new>
+
+// Plain thread-locals need no dynamic initialization, so touching them
+// inside malloc cannot recurse into the allocator
+static thread_local bool counting = false;
+static thread_local qint64 allocations = 0;
+
+// Counts one allocation if the calling thread is counting
+static inline void countAllocation() {
+    if (counting) {
+        ++allocations;
+    }
+}
+
+#if defined(__GLIBC__)
+
+// glibc lets the executable interpose the malloc family; forward to its implementation
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void __libc_free(void* pointer);
+
+void* malloc(size_t size) {
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) {
+    countAllocation();
+    return __libc_realloc(pointer, size);
+}
+
+void free(void* pointer) {
+    __libc_free(pointer);
+}
+}
+
+#else
+
+// Without malloc interposition, count what goes through operator new
+void* operator new(std::size_t size) {
+    countAllocation();
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+#endif
+
+// Starts counting the allocations of the calling thread from zero
+void AllocCounter::start() {
+    allocations = 0;
+    counting = true;
+}
+
+// Stops counting and returns the number of allocations since start()
+qint64 AllocCounter::stop() {
+    counting = false;
+    return allocations;
+}
+
+// Returns true if allocations that bypass operator new are counted too
+bool AllocCounter::coversMalloc() {
+#if defined(__GLIBC__)
+    return true;
+#else
+    return false;
+#endif
+}
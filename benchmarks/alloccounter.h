@@ -0,0 +1,16 @@
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+#include <QtGlobal>
+
+// Counts heap allocations made by the calling thread between start() and
+// stop(). With glibc every malloc-family call is counted, which covers
+// operator new and Qt's containers; elsewhere only operator new is.
+// Other threads (asset loaders, the thread pool) are never counted.
+namespace AllocCounter {
+void start();
+qint64 stop();
+bool coversMalloc();
+}
+
+#endif // ALLOCCOUNTER_H
@@ -0,0 +1,122 @@
+#include "bench_alloc.h"
+#include <QtTest>
+#include <QImage>
+#include <QPainter>
+#include "alloccounter.h"
+#include "game.h"
+#include "backgroundcache.h"
+#include "framecomposer.h"
+#include "spriteblitter.h"
+
+#define ALLOC_WARMUP_FRAMES 60 // Lets every cache, scratch vector and text layout reach its size
+#define ALLOC_COUNTED_FRAMES 200
+
+// ===========================
+// Allocation Checks
+// ===========================
+
+// Creates the game widget once; loading assets is not part of a frame
+void BenchAlloc::initTestCase() {
+    game = new Game();
+}
+
+// Destroys the game widget
+void BenchAlloc::cleanupTestCase() {
+    delete game;
+    game = nullptr;
+}
+
+// Every render path, on the default road and on dense traffic
+void BenchAlloc::steadyStateFrame_data() {
+    QTest::addColumn<int>("laneCount");
+    QTest::addColumn<int>("carCount");
+    QTest::addColumn<int>("path");
+    QTest::addColumn<bool>("composer");
+    for (BlitPath path : {BlitPath::Painter, BlitPath::Scalar, BlitPath::Sse2, BlitPath::Avx2}) {
+        QByteArray name = SpriteBlitter::name(path);
+        QTest::newRow((name + ", 3 lanes, 3 cars").constData()) << 3 << 3 << static_cast<int>(path) << false;
+        QTest::newRow((name + ", 6 lanes, 300 cars").constData()) << 6 << 300 << static_cast<int>(path) << false;
+    }
+    QTest::newRow("composer, 6 lanes, 300 cars") << 6 << 300 << static_cast<int>(BlitPath::Painter) << true;
+}
+
+// Runs one frame: the simulation steps a 60 Hz frame covers and the
+// particles, then either Game::render into an image or the composer
+// worker's snapshot and compose. A crash restarts the run with the next
+// seed, so every frame steps, collides and respawns.
+static void runFrame(Game* game, QPainter& painter, FrameComposer& composer, FrameSnapshot& snapshot,
+                     QImage& frame, bool useComposer, int frameIndex) {
+    Simulation& simulation = game->getSimulation();
+    for (int step = 0; step < 2; ++step) {
+        SimInput input;
+        input.steer = frameIndex % 50 == 0 ? 1 : (frameIndex % 50 == 25 ? -1 : 0);
+        simulation.step(SIM_STEP_MS, input);
+        if (simulation.isCrashed()) {
+            simulation.reset(simulation.getSeed() + 1);
+        }
+    }
+    game->updateParticles(1.0f / 60);
+    if (useComposer) {
+        game->captureSnapshot(snapshot);
+        composer.compose(frame, snapshot);
+    } else {
+        game->render(&painter);
+    }
+}
+
+// Fails if a warmed-up frame allocates
+void BenchAlloc::steadyStateFrame() {
+    QFETCH(int, laneCount);
+    QFETCH(int, carCount);
+    QFETCH(int, path);
+    QFETCH(bool, composer);
+    if (!SpriteBlitter::isSupported(static_cast<BlitPath>(path))) {
+        QSKIP("Blit path not supported on this CPU");
+    }
+
+    Simulation& simulation = game->getSimulation();
+    simulation.configure(laneCount, carCount);
+    game->setBlitPath(static_cast<BlitPath>(path));
+
+    BackgroundCache background;
+    background.load(":/img/background.gif", QSize(WINDOWS_SIZE_X, WINDOWS_SIZE_Y), 1.0);
+    FrameComposer worker;
+    worker.setImages(background, 1.0);
+    FrameSnapshot snapshot;
+
+    // The composer opens its own painter, and a paint device takes only one
+    QImage frame(WINDOWS_SIZE_X, WINDOWS_SIZE_Y, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter;
+    if (!composer) {
+        painter.begin(&frame);
+    }
+    for (int i = 0; i < ALLOC_WARMUP_FRAMES; ++i) {
+        runFrame(game, painter, worker, snapshot, frame, composer, i);
+    }
+
+    // Cleared so the check below sees whether the counted frames painted
+    if (composer) {
+        frame.fill(Qt::transparent);
+    }
+    qint64 particlesComposed = 0;
+    AllocCounter::start();
+    for (int i = 0; i < ALLOC_COUNTED_FRAMES; ++i) {
+        runFrame(game, painter, worker, snapshot, frame, composer, ALLOC_WARMUP_FRAMES + i);
+        particlesComposed += snapshot.particles.count;
+    }
+    qint64 allocations = AllocCounter::stop();
+
+    if (!composer) {
+        painter.end();
+    }
+    game->setBlitPath(BlitPath::Painter);
+    QVERIFY(!simulation.isCrashed());
+    if (composer) {
+        QVERIFY2(qAlpha(frame.pixel(WINDOWS_SIZE_X / 2, WINDOWS_SIZE_Y / 2)) == 255, "Composer did not paint the frame");
+        QVERIFY2(particlesComposed > 0, "No particles reached the composer");
+    }
+    if (!AllocCounter::coversMalloc()) {
+        qInfo("Only operator new is counted on this platform");
+    }
+    QVERIFY2(allocations == 0, qPrintable(QString("%1 allocations in %2 frames").arg(allocations).arg(ALLOC_COUNTED_FRAMES)));
+}
@@ -0,0 +1,26 @@
+#ifndef BENCH_ALLOC_H
+#define BENCH_ALLOC_H
+
+#include <QObject>
+
+class Game;
+
+// Steady-state allocation check: after warming up, a frame (simulation
+// steps with crashes and restarts, particles, snapshot and render or
+// compose) must not touch the heap. Fails instead of
+// measuring, so a regression shows up in every benchmark run.
+class BenchAlloc : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void steadyStateFrame_data();
+    void steadyStateFrame();
+
+private:
+    Game* game = nullptr;
+};
+
+#endif // BENCH_ALLOC_H
@@ -0,0 +1,138 @@
+#include "bench_batch.h"
+#include <QtTest>
+#include <QElapsedTimer>
+#include "batchenv.h"
+#include "simulation.h"
+
+// ===========================
+// Batch Environment Benchmarks
+// ===========================
+
+// Fills a seed list with distinct seeds
+static std::vector<quint64> makeSeeds(int count, quint64 first) {
+    std::vector<quint64> seeds(count);
+    for (int i = 0; i < count; ++i) {
+        seeds[i] = first + i;
+    }
+    return seeds;
+}
+
+// Restarts every finished game so the batch stays busy
+static void restartFinished(BatchEnv& env, quint64 seed) {
+    for (int game = 0; game < env.size(); ++game) {
+        if (env.isDone(game)) {
+            env.resetGame(game, seed + game);
+        }
+    }
+}
+
+// Batch sizes from one chunk per core to far more games than cache
+void BenchBatch::step_data() {
+    QTest::addColumn<int>("games");
+    QTest::addColumn<int>("carCount");
+    QTest::newRow("1024 games, 3 cars") << 1024 << 3;
+    QTest::newRow("16384 games, 3 cars") << 16384 << 3;
+    QTest::newRow("65536 games, 3 cars") << 65536 << 3;
+    QTest::newRow("16384 games, 12 cars") << 16384 << 12;
+}
+
+// Measures one step() of the whole batch
+void BenchBatch::step() {
+    QFETCH(int, games);
+    QFETCH(int, carCount);
+
+    BatchEnv env(DEFAULT_LANE_COUNT, carCount);
+    env.reset(makeSeeds(games, 1));
+    std::vector<qint8> actions(games, 0);
+    quint64 seed = games;
+
+    QBENCHMARK {
+        env.step(actions);
+        restartFinished(env, seed);
+        seed += games;
+    }
+}
+
+// Reports environment steps per second with random steering and restarts
+void BenchBatch::throughput() {
+    const int games = 65536;
+    const int steps = 1000;
+    BatchEnv env;
+    env.reset(makeSeeds(games, 1));
+
+    std::vector<qint8> actions(games, 0);
+    Rng rng(1);
+    quint64 seed = games;
+    qint64 stepNs = 0;
+    QElapsedTimer timer;
+    for (int i = 0; i < steps; ++i) {
+        for (qint8& action : actions) {
+            action = static_cast<qint8>(rng.bounded(3)) - 1;
+        }
+        timer.start();
+        env.step(actions);
+        restartFinished(env, seed);
+        stepNs += timer.nsecsElapsed();
+        seed += games;
+    }
+
+    double rate = double(games) * steps * 1e9 / qMax<qint64>(1, stepNs);
+    qInfo("%d games on %d threads: %.1f million environment steps per second",
+          games, env.getThreadCount(), rate / 1e6);
+}
+
+// Roads from the default game to crowded wide ones, up to the car limit
+void BenchBatch::matchesSimulation_data() {
+    QTest::addColumn<int>("laneCount");
+    QTest::addColumn<int>("carCount");
+    QTest::newRow("3 lanes, 3 cars") << 3 << 3;
+    QTest::newRow("3 lanes, 12 cars") << 3 << 12;
+    QTest::newRow("6 lanes, 64 cars") << 6 << BATCH_MAX_TRAFFIC;
+}
+
+// Fails unless each game, stepped with random steering, has the same state
+// after every tick as a Simulation with the same seed and steering
+void BenchBatch::matchesSimulation() {
+    QFETCH(int, laneCount);
+    QFETCH(int, carCount);
+    const int games = 64;
+    const int ticks = 6000;
+
+    BatchEnv env(laneCount, carCount);
+    const std::vector<quint64> seeds = makeSeeds(games, 0x9E3779B97F4A7C15ULL);
+    env.reset(seeds);
+    std::vector<Simulation> simulations;
+    simulations.reserve(games);
+    for (int game = 0; game < games; ++game) {
+        simulations.emplace_back(laneCount, carCount, seeds[game]);
+    }
+
+    std::vector<qint8> actions(games, 0);
+    Rng rng(1);
+    for (int i = 0; i < ticks; ++i) {
+        // Mostly straight, with a lane change now and then
+        for (qint8& action : actions) {
+            const quint32 roll = rng.bounded(40);
+            action = roll == 0 ? -1 : roll == 1 ? 1 : 0;
+        }
+        env.step(actions);
+
+        for (int game = 0; game < games; ++game) {
+            Simulation& simulation = simulations[game];
+            if (!simulation.isCrashed()) {
+                SimInput input;
+                input.steer = actions[game];
+                simulation.step(SIM_STEP_MS, input);
+            }
+            bool same = env.isDone(game) == simulation.isCrashed() && env.getTick(game) == simulation.getTick() &&
+                        env.getElapsed(game) == simulation.getElapsed() &&
+                        env.getPlayerLane(game) == simulation.getPlayerLane();
+            for (int car = 0; car < carCount && same; ++car) {
+                same = env.getTrafficY(game, car) == simulation.getTraffic().getY(car);
+            }
+            if (!same) {
+                QFAIL(qPrintable(QString("Game %1 differs from its Simulation after step %2").arg(game).arg(i + 1)));
+            }
+        }
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef BENCH_BATCH_H
+#define BENCH_BATCH_H
+
+#include <QObject>
+
+// Batch environment benchmarks: one step over thousands of games, the
+// sustained environment-step rate with finished games restarted, and a check
+// that every game plays exactly like a Simulation with its seed
+class BenchBatch : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void step_data();
+    void step();
+    void throughput();
+    void matchesSimulation_data();
+    void matchesSimulation();
+};
+
+#endif // BENCH_BATCH_H
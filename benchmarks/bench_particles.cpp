@@ -0,0 +1,102 @@
+#include "bench_particles.h"
+#include <QtTest>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+#include "particlerenderer.h"
+#include "particles.h"
+#include "shared.h"
+
+#define PARTICLE_BUDGET_COUNT 30000 // Live particles the frame budget check keeps up
+#define PARTICLE_BUDGET_FRAMES 120
+#define PARTICLE_BUDGET_MS 8.0 // Half of a 60 Hz frame, leaving the rest for the sprites
+
+// ===========================
+// Particle Benchmarks
+// ===========================
+
+// Emits crashes spread over the screen until count particles are alive
+static void fill(ParticleSystem& particles, int count) {
+    for (int i = 0; particles.size() < count; ++i) {
+        particles.emitCrash(50.0f + (i * 97) % (WINDOWS_SIZE_X - 100), 100.0f + (i * 211) % (WINDOWS_SIZE_Y - 200));
+    }
+}
+
+// A few crashes, and the pool filled far beyond what one crash emits
+void BenchParticles::update_data() {
+    QTest::addColumn<int>("count");
+    QTest::newRow("1k particles") << 1000;
+    QTest::newRow("10k particles") << 10000;
+    QTest::newRow("50k particles") << 50000;
+}
+
+// Measures one update of every live particle. QBENCHMARK repeats until a
+// run takes long enough, which could add up to seconds of particle life, so
+// the time step is zero: the update does the same work on every particle
+// and the live count stays constant.
+void BenchParticles::update() {
+    QFETCH(int, count);
+    ParticleSystem particles;
+    fill(particles, count);
+    const int live = particles.size();
+    QBENCHMARK {
+        particles.update(0.0f);
+    }
+    QCOMPARE(particles.size(), live);
+}
+
+// QPainter with one drawRects() call per color, and blending into the pixels
+void BenchParticles::draw_data() {
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("software");
+    QTest::newRow("painter, 10k particles") << 10000 << false;
+    QTest::newRow("painter, 30k particles") << 30000 << false;
+    QTest::newRow("software, 10k particles") << 10000 << true;
+    QTest::newRow("software, 30k particles") << 30000 << true;
+}
+
+// Measures drawing a batch into a window-sized frame after the particles
+// have spread for half a second
+void BenchParticles::draw() {
+    QFETCH(int, count);
+    QFETCH(bool, software);
+    ParticleSystem particles;
+    fill(particles, count);
+    particles.update(0.5f);
+
+    ParticleRenderer renderer;
+    QImage frame(WINDOWS_SIZE_X, WINDOWS_SIZE_Y, QImage::Format_ARGB32_Premultiplied);
+    frame.fill(Qt::darkGray);
+    if (software) {
+        QBENCHMARK {
+            renderer.blend(frame, particles.getBatch(), 1.0);
+        }
+    } else {
+        QPainter painter(&frame);
+        QBENCHMARK {
+            renderer.draw(&painter, particles.getBatch());
+        }
+    }
+}
+
+// Fails if updating and drawing PARTICLE_BUDGET_COUNT particles, topped up
+// with new crashes as they expire, takes more than PARTICLE_BUDGET_MS a frame
+void BenchParticles::frameBudget() {
+    ParticleSystem particles;
+    ParticleRenderer renderer;
+    QImage frame(WINDOWS_SIZE_X, WINDOWS_SIZE_Y, QImage::Format_ARGB32_Premultiplied);
+    frame.fill(Qt::darkGray);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < PARTICLE_BUDGET_FRAMES; ++i) {
+        fill(particles, PARTICLE_BUDGET_COUNT);
+        particles.update(1.0f / 60);
+        renderer.blend(frame, particles.getBatch(), 1.0);
+    }
+    double frameMs = timer.nsecsElapsed() / 1e6 / PARTICLE_BUDGET_FRAMES;
+
+    qInfo("%d particles: %.2f ms per frame", PARTICLE_BUDGET_COUNT, frameMs);
+    QVERIFY2(frameMs < PARTICLE_BUDGET_MS,
+             qPrintable(QString("%1 ms per frame for %2 particles").arg(frameMs).arg(PARTICLE_BUDGET_COUNT)));
+}
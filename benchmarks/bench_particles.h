@@ -0,0 +1,21 @@
+#ifndef BENCH_PARTICLES_H
+#define BENCH_PARTICLES_H
+
+#include <QObject>
+
+// Particle benchmarks: the vectorized update, both ways of drawing a batch,
+// and a frame budget check that fails if tens of thousands of particles no
+// longer fit in a frame next to the sprites
+class BenchParticles : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void update_data();
+    void update();
+    void draw_data();
+    void draw();
+    void frameBudget();
+};
+
+#endif // BENCH_PARTICLES_H
@@ -0,0 +1,119 @@
+#include "bench_render.h"
+#include <QtTest>
+#include <QImage>
+#include <QPainter>
+#include "game.h"
+#include "backgroundcache.h"
+#include "framecomposer.h"
+#include "spriteblitter.h"
+#include "spritecache.h"
+
+// ===========================
+// Render Benchmarks
+// ===========================
+
+// Creates the game widget once; loading sprites and the background is not measured
+void BenchRender::initTestCase() {
+    game = new Game();
+}
+
+// Destroys the game widget
+void BenchRender::cleanupTestCase() {
+    delete game;
+    game = nullptr;
+}
+
+// Default road and dense traffic on a wide road
+void BenchRender::renderFrame_data() {
+    QTest::addColumn<int>("laneCount");
+    QTest::addColumn<int>("carCount");
+    QTest::newRow("3 lanes, 3 cars") << 3 << 3;
+    QTest::newRow("6 lanes, 300 cars") << 6 << 300;
+}
+
+// Steps until traffic has reached the screen so sprites are actually drawn
+static void fillScreen(Simulation& simulation, int laneCount, int carCount) {
+    simulation.configure(laneCount, carCount);
+    for (int i = 0; i < 400 && !simulation.isCrashed(); ++i) {
+        simulation.step(SIM_STEP_MS, SimInput());
+    }
+}
+
+// Measures composing one frame into a window-sized image
+void BenchRender::renderFrame() {
+    QFETCH(int, laneCount);
+    QFETCH(int, carCount);
+    fillScreen(game->getSimulation(), laneCount, carCount);
+
+    QImage frame(WINDOWS_SIZE_X, WINDOWS_SIZE_Y, QImage::Format_ARGB32_Premultiplied);
+    QBENCHMARK {
+        QPainter painter(&frame);
+        game->render(&painter);
+    }
+}
+
+// Each blit path on the default road and on dense traffic
+void BenchRender::composeFrame_data() {
+    QTest::addColumn<int>("laneCount");
+    QTest::addColumn<int>("carCount");
+    QTest::addColumn<int>("path");
+    for (BlitPath path : {BlitPath::Painter, BlitPath::Scalar, BlitPath::Sse2, BlitPath::Avx2}) {
+        QByteArray name = SpriteBlitter::name(path);
+        QTest::newRow((name + ", 3 lanes, 3 cars").constData()) << 3 << 3 << static_cast<int>(path);
+        QTest::newRow((name + ", 6 lanes, 300 cars").constData()) << 6 << 300 << static_cast<int>(path);
+    }
+}
+
+// Measures the worker side of threaded rendering: snapshot plus composition
+void BenchRender::composeFrame() {
+    QFETCH(int, laneCount);
+    QFETCH(int, carCount);
+    QFETCH(int, path);
+    if (!SpriteBlitter::isSupported(static_cast<BlitPath>(path))) {
+        QSKIP("Blit path not supported on this CPU");
+    }
+    fillScreen(game->getSimulation(), laneCount, carCount);
+
+    BackgroundCache background;
+    background.load(":/img/background.gif", QSize(WINDOWS_SIZE_X, WINDOWS_SIZE_Y), 1.0);
+    FrameComposer composer;
+    composer.setBlitPath(static_cast<BlitPath>(path));
+    composer.setImages(background, 1.0);
+
+    FrameSnapshot snapshot;
+    QImage frame(WINDOWS_SIZE_X, WINDOWS_SIZE_Y, QImage::Format_ARGB32_Premultiplied);
+    QBENCHMARK {
+        game->captureSnapshot(snapshot);
+        composer.compose(frame, snapshot);
+    }
+}
+
+// Software kernels against QPainter, for a sprite fully on screen and one
+// entering from above and half clipped
+void BenchRender::blitSprite_data() {
+    QTest::addColumn<int>("path");
+    QTest::addColumn<int>("y");
+    for (BlitPath path : {BlitPath::Painter, BlitPath::Scalar, BlitPath::Sse2, BlitPath::Avx2}) {
+        QByteArray name = SpriteBlitter::name(path);
+        QTest::newRow((name + ", on screen").constData()) << static_cast<int>(path) << 250;
+        QTest::newRow((name + ", clipped").constData()) << static_cast<int>(path) << -CAR_SIZE_Y / 2;
+    }
+}
+
+// Measures blending one traffic car sprite into a window-sized frame
+void BenchRender::blitSprite() {
+    QFETCH(int, path);
+    QFETCH(int, y);
+    if (!SpriteBlitter::isSupported(static_cast<BlitPath>(path))) {
+        QSKIP("Blit path not supported on this CPU");
+    }
+
+    QImage sprite = SpriteCache::instance().pixmap(SpriteId::Traffic).toImage()
+                        .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    sprite.setDevicePixelRatio(1.0);
+    QImage frame(WINDOWS_SIZE_X, WINDOWS_SIZE_Y, QImage::Format_ARGB32_Premultiplied);
+    frame.fill(Qt::white);
+    QBENCHMARK {
+        SpriteBlitter::blend(frame, sprite, QPoint(150, y), static_cast<BlitPath>(path));
+    }
+}
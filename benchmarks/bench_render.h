@@ -0,0 +1,28 @@
+#ifndef BENCH_RENDER_H
+#define BENCH_RENDER_H
+
+#include <QObject>
+
+class Game;
+
+// Rendering benchmarks: Game::render, the off-thread composer and the
+// software sprite blitter into an offscreen QImage
+class BenchRender : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void renderFrame_data();
+    void renderFrame();
+    void composeFrame_data();
+    void composeFrame();
+    void blitSprite_data();
+    void blitSprite();
+
+private:
+    Game* game = nullptr;
+};
+
+#endif // BENCH_RENDER_H
@@ -0,0 +1,228 @@
+#include "bench_traffic.h"
+#include <QtTest>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include "simulation.h"
+#include "collisionmask.h"
+#include "traffic.h"
+#include "runlog.h"
+#include "autopilot.h"
+
+// ===========================
+// Traffic Benchmarks
+// ===========================
+
+// Shared rows: default road, and dense traffic on normal and wide roads
+void BenchTraffic::addTrafficRows() {
+    QTest::addColumn<int>("laneCount");
+    QTest::addColumn<int>("carCount");
+    QTest::newRow("3 lanes, 3 cars") << 3 << 3;
+    QTest::newRow("3 lanes, 300 cars") << 3 << 300;
+    QTest::newRow("6 lanes, 600 cars") << 6 << 600;
+    QTest::newRow("8 lanes, 2000 cars") << 8 << 2000;
+}
+
+void BenchTraffic::advance_data() {
+    addTrafficRows();
+}
+
+// Measures the structure-of-arrays movement loop on its own
+void BenchTraffic::advance() {
+    QFETCH(int, laneCount);
+    QFETCH(int, carCount);
+
+    Traffic traffic(laneCount);
+    traffic.reserve(carCount);
+    for (int i = 0; i < carCount; ++i) {
+        traffic.add(i % laneCount, -i * float(LANE_MIN_GAP));
+    }
+
+    QBENCHMARK {
+        traffic.advance(1.0f);
+    }
+}
+
+void BenchTraffic::step_data() {
+    addTrafficRows();
+}
+
+// Measures a full simulation tick: movement, respawns and collision
+void BenchTraffic::step() {
+    QFETCH(int, laneCount);
+    QFETCH(int, carCount);
+
+    Simulation simulation(laneCount, carCount, 1);
+    SimInput input;
+
+    QBENCHMARK {
+        simulation.step(SIM_STEP_MS, input);
+        if (simulation.isCrashed()) {
+            simulation.reset();
+        }
+    }
+}
+
+void BenchTraffic::collision_data() {
+    addTrafficRows();
+}
+
+// Measures the player collision query; with lane buckets it should stay
+// nearly flat as the number of cars grows
+void BenchTraffic::collision() {
+    QFETCH(int, laneCount);
+    QFETCH(int, carCount);
+
+    Simulation simulation(laneCount, carCount, 1);
+    bool collided = false;
+
+    QBENCHMARK {
+        collided ^= simulation.checkCollision() >= 0.0f;
+    }
+    Q_UNUSED(collided);
+}
+
+void BenchTraffic::narrowPhase_data() {
+    QTest::addColumn<bool>("masks");
+    QTest::newRow("QRect::intersects") << false;
+    QTest::newRow("collision masks") << true;
+}
+
+// Compares the pixel-accurate mask test with the padded rectangle test it
+// replaced, over a traffic car placed on a 7 pixel grid of every offset
+// where the two car boxes overlap
+void BenchTraffic::narrowPhase() {
+    QFETCH(bool, masks);
+
+    QVector<QPoint> offsets;
+    for (int dy = 1 - CAR_SIZE_Y; dy < CAR_SIZE_Y; dy += 7) {
+        for (int dx = 1 - CAR_SIZE_X; dx < CAR_SIZE_X; dx += 7) {
+            offsets.append(QPoint(dx, dy));
+        }
+    }
+    const CollisionMask& player = CollisionMask::forSprite(SpriteId::Player);
+    const CollisionMask& traffic = CollisionMask::forSprite(SpriteId::Traffic);
+    const int padding = 30; // The padding of the rectangle test
+    const QRect playerRect(0, 0, CAR_SIZE_X - padding, CAR_SIZE_Y - padding);
+    int hits = 0;
+
+    QBENCHMARK {
+        hits = 0;
+        for (const QPoint& offset : offsets) {
+            if (masks) {
+                hits += player.overlaps(0, 0, traffic, offset.x(), offset.y());
+            } else {
+                hits += playerRect.intersects(QRect(offset, playerRect.size()));
+            }
+        }
+    }
+    qInfo("%d of %d pairs touch", hits, int(offsets.size()));
+}
+
+// Replays a fixed-seed run with periodic steering for a fixed number of
+// ticks; the same workload the --replay mode uses for profiling
+void BenchTraffic::replay() {
+    RunLog log;
+    log.begin(1, SIM_STEP_MS, DEFAULT_LANE_COUNT, DEFAULT_TRAFFIC_COUNT);
+    for (quint32 tick = 50; tick < 10000; tick += 50) {
+        log.record(tick, 0, (tick / 50) % 2 ? -1 : 1);
+    }
+
+    QBENCHMARK {
+        RunOutcome outcome = log.replay(10000);
+        Q_UNUSED(outcome);
+    }
+}
+
+// Fails unless a run recorded like Game records it, saved and loaded again,
+// replays to exactly the same outcome
+void BenchTraffic::replayMatches() {
+    const quint64 seed = 0x9E3779B97F4A7C15ULL;
+    Simulation simulation(DEFAULT_LANE_COUNT, DEFAULT_TRAFFIC_COUNT, seed);
+    simulation.setLaneChangeTicks(12);
+    RunLog log;
+    log.begin(seed, SIM_STEP_MS, DEFAULT_LANE_COUNT, DEFAULT_TRAFFIC_COUNT, simulation.getLaneChangeTicks());
+
+    // Scripted steering: weave across the road at uneven intervals until a crash
+    while (!simulation.isCrashed() && simulation.getTick() < 100000) {
+        SimInput input;
+        const quint32 tick = simulation.getTick();
+        if (tick % 37 == 0) {
+            input.steer = (tick / 37) % 3 == 0 ? -1 : 1;
+            log.record(tick, tick * SIM_STEP_MS, input.steer);
+        }
+        simulation.step(SIM_STEP_MS, input);
+    }
+    QVERIFY2(simulation.isCrashed(), "Scripted run did not crash");
+
+    RunOutcome recorded;
+    recorded.crashed = simulation.isCrashed();
+    recorded.crashTick = simulation.getTick();
+    recorded.playerLane = simulation.getPlayerLane();
+    recorded.elapsed = simulation.getElapsed();
+    log.finish(recorded);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("scripted.runlog");
+    QVERIFY(log.save(path));
+    RunLog loaded;
+    QVERIFY(loaded.load(path));
+
+    RunOutcome result = loaded.replay(recorded.crashTick + RUN_LOG_REPLAY_SLACK_TICKS);
+    QCOMPARE(result.crashed, recorded.crashed);
+    QCOMPARE(result.crashTick, recorded.crashTick);
+    QCOMPARE(result.playerLane, recorded.playerLane);
+    QCOMPARE(result.elapsed, recorded.elapsed);
+}
+
+// Fails if a tick with several hundred cars is not well under 1 ms
+void BenchTraffic::tickBudget() {
+    const int ticks = 10000;
+    Simulation simulation(4, 500, 1);
+    SimInput input;
+
+    qint64 stepNs = 0;
+    QElapsedTimer timer;
+    for (int i = 0; i < ticks; ++i) {
+        timer.start();
+        simulation.step(SIM_STEP_MS, input);
+        stepNs += timer.nsecsElapsed();
+        if (simulation.isCrashed()) {
+            simulation.reset();
+        }
+    }
+
+    double averageUs = stepNs / 1000.0 / ticks;
+    qInfo("500 cars: %.2f us per tick", averageUs);
+    QVERIFY2(averageUs < 250.0, "Traffic tick exceeded a quarter of the 1 ms budget");
+}
+
+// Measures a save and restore round trip of the default game
+void BenchTraffic::snapshot() {
+    Simulation simulation(DEFAULT_LANE_COUNT, DEFAULT_TRAFFIC_COUNT, 1);
+    for (int i = 0; i < 500; ++i) {
+        simulation.step(SIM_STEP_MS, SimInput());
+    }
+    Simulation copy;
+    SimSnapshot state;
+
+    QBENCHMARK {
+        simulation.save(state);
+        copy.restore(state);
+    }
+}
+
+// Measures one autopilot decision from a state a few seconds into a run
+void BenchTraffic::autopilotDecision() {
+    Simulation simulation(DEFAULT_LANE_COUNT, DEFAULT_TRAFFIC_COUNT, 1);
+    for (int i = 0; i < 300; ++i) {
+        simulation.step(SIM_STEP_MS, SimInput());
+    }
+    QVERIFY(!simulation.isCrashed());
+    Autopilot autopilot;
+
+    QBENCHMARK {
+        int steer = autopilot.decide(simulation);
+        Q_UNUSED(steer);
+    }
+}
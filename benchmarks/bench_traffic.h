@@ -0,0 +1,32 @@
+#ifndef BENCH_TRAFFIC_H
+#define BENCH_TRAFFIC_H
+
+#include <QObject>
+
+// Simulation benchmarks: traffic movement, full ticks, collision queries
+// and the narrow phase behind them, replaying a recorded run and checking
+// that it ends like the original, snapshots and autopilot decisions
+class BenchTraffic : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void advance_data();
+    void advance();
+    void step_data();
+    void step();
+    void collision_data();
+    void collision();
+    void narrowPhase_data();
+    void narrowPhase();
+    void replay();
+    void replayMatches();
+    void tickBudget();
+    void snapshot();
+    void autopilotDecision();
+
+private:
+    void addTrafficRows();
+};
+
+#endif // BENCH_TRAFFIC_H
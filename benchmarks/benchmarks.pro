@@ -0,0 +1,34 @@
+# Benchmarks for the simulation and rendering paths. Build and run
+# separately from the game:
+#   qmake benchmarks/benchmarks.pro && make && ./benchmarks
+# For machine-readable results, one file per benchmark class:
+#   ./benchmarks --output-dir results --format xml
+# Rendering uses the offscreen platform unless QT_QPA_PLATFORM is set.
+
+QT += testlib widgets
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TEMPLATE = app
+TARGET = benchmarks
+
+include(../core.pri)
+include(../gui.pri)
+
+SOURCES += \
+    alloccounter.cpp \
+    bench_alloc.cpp \
+    bench_batch.cpp \
+    bench_particles.cpp \
+    bench_render.cpp \
+    bench_traffic.cpp \
+    main.cpp
+
+HEADERS += \
+    alloccounter.h \
+    bench_alloc.h \
+    bench_batch.h \
+    bench_particles.h \
+    bench_render.h \
+    bench_traffic.h
@@ -0,0 +1,56 @@
+#include <QApplication>
+#include <QDir>
+#include <QStringList>
+#include <QtTest>
+#include "bench_traffic.h"
+#include "bench_render.h"
+#include "bench_batch.h"
+#include "bench_alloc.h"
+#include "bench_particles.h"
+
+// Runs every benchmark class. Arguments are passed to QtTest, except:
+//   --output-dir <dir>  write one result file per class into <dir>
+//   --format <fmt>      QtTest format for those files: xml (default), csv,
+//                       junitxml, tap, txt
+// so results can be collected and compared between builds.
+int main(int argc, char *argv[])
+{
+    // Rendering is measured without a display
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    QStringList arguments = app.arguments();
+    QString outputDir;
+    QString format = "xml";
+    for (int i = 1; i + 1 < arguments.size(); ) {
+        if (arguments[i] == "--output-dir" || arguments[i] == "--format") {
+            (arguments[i] == "--format" ? format : outputDir) = arguments[i + 1];
+            arguments.remove(i, 2);
+        } else {
+            ++i;
+        }
+    }
+    if (!outputDir.isEmpty()) {
+        QDir().mkpath(outputDir);
+    }
+
+    BenchTraffic traffic;
+    BenchRender render;
+    BenchBatch batch;
+    BenchAlloc alloc;
+    BenchParticles particles;
+    const QList<QObject*> benchmarks = { &traffic, &render, &batch, &alloc, &particles };
+
+    int failures = 0;
+    for (QObject* benchmark : benchmarks) {
+        QStringList benchmarkArguments = arguments;
+        if (!outputDir.isEmpty()) {
+            QString file = QDir(outputDir).filePath(QString(benchmark->metaObject()->className()) + "." + format);
+            benchmarkArguments << "-o" << file + "," + format;
+        }
+        failures += QTest::qExec(benchmark, benchmarkArguments);
+    }
+    return failures;
+}
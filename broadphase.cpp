@@ -0,0 +1,80 @@
+#include "broadphase.h"
+#include <algorithm>
+
+// ===========================
+// BroadPhase Class Implementation
+// ===========================
+
+// Removes every car and sets up one empty bucket per lane
+void BroadPhase::reset(int laneCount) {
+    lanes.resize(laneCount);
+    for (std::vector<int>& bucket : lanes) {
+        bucket.clear();
+    }
+}
+
+// Adds a new car to the bucket of its lane
+void BroadPhase::insert(const Traffic &traffic, int index) {
+    insertSorted(traffic, lanes[traffic.getLane(index)], index);
+}
+
+// Moves a car to its sorted place after its Y was changed with Traffic::setY
+void BroadPhase::relocate(const Traffic &traffic, int index) {
+    std::vector<int>& bucket = lanes[traffic.getLane(index)];
+
+    // Wrapped and respawned cars are usually at either end, so search from the back
+    auto it = std::find(bucket.rbegin(), bucket.rend(), index);
+    if (it != bucket.rend()) {
+        bucket.erase(std::next(it).base());
+    }
+    insertSorted(traffic, bucket, index);
+}
+
+// Re-sorts each bucket after movement; buckets are nearly sorted, so the
+// insertion sort is a single linear pass when no car overtook another
+void BroadPhase::restoreOrder(const Traffic &traffic) {
+    for (std::vector<int>& bucket : lanes) {
+        for (size_t i = 1; i < bucket.size(); ++i) {
+            int index = bucket[i];
+            float y = traffic.getY(index);
+            size_t j = i;
+            while (j > 0 && traffic.getY(bucket[j - 1]) > y) {
+                bucket[j] = bucket[j - 1];
+                --j;
+            }
+            bucket[j] = index;
+        }
+    }
+}
+
+// Returns the car indices of a lane, topmost first
+const std::vector<int>& BroadPhase::getLane(int lane) const {
+    return lanes[lane];
+}
+
+// Returns the topmost car of a lane other than exclude, or -1 if there is none
+int BroadPhase::laneTop(int lane, int exclude) const {
+    const std::vector<int>& bucket = lanes[lane];
+    for (int index : bucket) {
+        if (index != exclude) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+// Returns the position in a lane's bucket of the first car with Y >= y
+int BroadPhase::lowerBound(const Traffic &traffic, int lane, float y) const {
+    const std::vector<int>& bucket = lanes[lane];
+    auto it = std::lower_bound(bucket.begin(), bucket.end(), y,
+                               [&traffic](int index, float value) { return traffic.getY(index) < value; });
+    return static_cast<int>(it - bucket.begin());
+}
+
+// Inserts a car into a bucket at the position given by its Y
+void BroadPhase::insertSorted(const Traffic &traffic, std::vector<int>& bucket, int index) {
+    float y = traffic.getY(index);
+    auto it = std::upper_bound(bucket.begin(), bucket.end(), y,
+                               [&traffic](float value, int other) { return value < traffic.getY(other); });
+    bucket.insert(it, index);
+}
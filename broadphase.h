@@ -0,0 +1,30 @@
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <vector>
+#include "traffic.h"
+
+// Broad phase for traffic queries: one bucket per lane holding car indices
+// sorted by Y, topmost first. Cars in a lane keep their order while they
+// move, so buckets are maintained incrementally: a wrapped car is moved from
+// the bottom of its bucket to its new place, and restoreOrder() fixes the
+// few swaps caused by cars with different speed multipliers.
+class BroadPhase
+{
+public:
+    void reset(int laneCount);
+    void insert(const Traffic& traffic, int index);
+    void relocate(const Traffic& traffic, int index);
+    void restoreOrder(const Traffic& traffic);
+
+    const std::vector<int>& getLane(int lane) const;
+    int laneTop(int lane, int exclude) const;
+    int lowerBound(const Traffic& traffic, int lane, float y) const;
+
+private:
+    std::vector<std::vector<int>> lanes;
+
+    void insertSorted(const Traffic& traffic, std::vector<int>& bucket, int index);
+};
+
+#endif // BROADPHASE_H
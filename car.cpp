@@ -1,48 +1,25 @@
 #include "car.h"
-#include <QDebug>
+#include "gamelog.h"
 // ===========================
 // Car Class Implementation
 // ===========================
 
 // Constructor initializes the car's position to (0, 0)
-Car::Car() : carX(0), carY(0) {}
+Car::Car() : carX(0), carY(0.0f), previousY(0.0f), sprite(SpriteId::Traffic) {}
 
-// Checks if the car's image is null (not loaded)
-bool Car::isNull() const {
-    return carImage.isNull();
-}
-
-// Loads and scales the car image from the given path
-void Car::loadImage(const QString &path, int x, int y) {
-    if (!carImage.load(path)) {
-        qDebug() << "Failed to load image from" << path;
-        return;
-    }
-    carImage = carImage.scaled(x, y, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    qDebug() << "Loaded and scaled image from" << path << "to size (" << x << "," << y << ")";
-}
-
-// Updates the car's Y position to simulate downward movement
-void Car::updateCar(int speed) {
-    carY += speed;
-    qDebug() << "Updating car position. New Y:" << carY;
-    if (carY > WINDOWS_SIZE_Y) {
-        qDebug() << "Car moved off-screen, wrapping around!";
-        carY = -CAR_SIZE_Y - (rand() % 800);
-        qDebug() << "Car Y reset to:" << carY;
-    }
-}
+// Constructor initializes a car at (0, 0) drawn with the given sprite
+Car::Car(SpriteId sprite) : carX(0), carY(0.0f), previousY(0.0f), sprite(sprite) {}
 
 // Moves the car vertically by the specified step
-void Car::moveY(int step) {
+void Car::moveY(float step) {
     carY += step;
-    qDebug() << "Car moved vertically by" << step << "pixels. New Y:" << carY;
+    LOG_TRACE(Car, "Car moved vertically by %.1f pixels. New Y: %.1f", step, carY);
 }
 
 // Moves the car horizontally by the specified step
 void Car::moveX(int step) {
     carX += step;
-    qDebug() << "Car moved horizontally by" << step << "pixels. New X:" << carX;
+    LOG_TRACE(Car, "Car moved horizontally by %.0f pixels. New X: %.0f", step, carX);
 }
 
 // Returns the current X position of the car
@@ -51,23 +28,34 @@ int Car::getX() const {
 }
 
 // Returns the current Y position of the car
-int Car::getY() const {
+float Car::getY() const {
     return carY;
 }
 
+// Returns the Y position blended between the previous and current step (alpha in [0, 1])
+float Car::getRenderY(float alpha) const {
+    return previousY + (carY - previousY) * alpha;
+}
+
 // Sets the car's X position
 void Car::setX(int x) {
     carX = x;
-    qDebug() << "Car X position set to:" << x;
+    LOG_TRACE(Car, "Car X position set to: %.0f", x);
 }
 
-// Sets the car's Y position
-void Car::setY(int y) {
+// Sets the car's Y position (a teleport, so nothing is interpolated)
+void Car::setY(float y) {
     carY = y;
-    qDebug() << "Car Y position set to:" << y;
+    previousY = y;
+    LOG_TRACE(Car, "Car Y position set to: %.1f", y);
+}
+
+// Sets the sprite the car is drawn with
+void Car::setSprite(SpriteId id) {
+    sprite = id;
 }
 
-// Returns the car's image pixmap
-QPixmap Car::getPixmap() const {
-    return carImage;
+// Returns the sprite the car is drawn with
+SpriteId Car::getSprite() const {
+    return sprite;
 }
@@ -1,30 +1,38 @@
 #ifndef CAR_H
 #define CAR_H
 
-#include <QPixmap>
 #include "shared.h"
 
 #define CAR_SIZE_X 100
 #define CAR_SIZE_Y 200
 
+// Which sprite a car is drawn with; resolved to a pixmap by SpriteCache
+enum class SpriteId : unsigned char {
+    Player,
+    Traffic,
+    Crashed,
+    Count
+};
+
 class Car {
 private:
     int carX;
-    int carY;
-    QPixmap carImage;
+    float carY;
+    float previousY; // Y before the last simulation step, used for interpolation
+    SpriteId sprite;
 
 public:
     Car();
-    QPixmap getPixmap() const; // Return by value
-    void loadImage(const QString& path, int x, int y);
-    void updateCar(int speed);
+    explicit Car(SpriteId sprite);
     void setX(int x);
-    void setY(int y);
+    void setY(float y);
     int getX() const;
-    int getY() const;
+    float getY() const;
+    float getRenderY(float alpha) const;
     void moveX(int step);
-    void moveY(int step);
-    bool isNull() const;
+    void moveY(float step);
+    void setSprite(SpriteId id);
+    SpriteId getSprite() const;
 };
 
 #endif // CAR_H
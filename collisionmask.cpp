@@ -0,0 +1,98 @@
+#include "collisionmask.h"
+#include <algorithm>
+#include <cmath>
+
+// Returns word index of a mask row moved shift columns to the right (left
+// if negative), with zeros shifted in
+static quint64 shiftedWord(const quint64* row, int index, int shift) {
+    const int source = index * 64 - shift; // Column of the row that lands on bit 0
+    const int word = source >> 6;
+    const int bit = source & 63;
+    const quint64 low = word >= 0 && word < MASK_WORDS ? row[word] : 0;
+    if (bit == 0) {
+        return low;
+    }
+    const quint64 high = word + 1 >= 0 && word + 1 < MASK_WORDS ? row[word + 1] : 0;
+    return (low >> bit) | (high << (64 - bit));
+}
+
+// Narrows [enter, exit] to the part of a step in which an offset moving
+// linearly from r0 to r1 stays strictly between low and high.
+// Returns false if that part is empty.
+static bool sweepAxis(float r0, float r1, float low, float high, float& enter, float& exit) {
+    const float velocity = r1 - r0;
+    if (velocity == 0.0f) {
+        return low < r0 && r0 < high;
+    }
+    float first = (low - r0) / velocity;
+    float last = (high - r0) / velocity;
+    if (first > last) {
+        std::swap(first, last);
+    }
+    enter = std::max(enter, first);
+    exit = std::min(exit, last);
+    return enter < exit;
+}
+
+// ===========================
+// CollisionMask Implementation
+// ===========================
+
+// Returns the mask of a car sprite
+const CollisionMask& CollisionMask::forSprite(SpriteId id) {
+    return bySprite[static_cast<int>(id)];
+}
+
+// Returns true if this mask drawn at (x, y) shares a solid pixel with other
+// drawn at (otherX, otherY). The bounds reject most pairs; otherwise only
+// the rows inside both bounds are compared, from the top.
+bool CollisionMask::overlaps(int x, int y, const CollisionMask& other, int otherX, int otherY) const {
+    const int dx = otherX - x;
+    const int dy = otherY - y;
+    if (left >= other.right + dx || other.left + dx >= right || top >= other.bottom + dy || other.top + dy >= bottom) {
+        return false;
+    }
+
+    const int first = std::max(top, other.top + dy);
+    const int last = std::min(bottom, other.bottom + dy);
+    for (int row = first; row < last; ++row) {
+        const quint64* mine = rows[row];
+        const quint64* theirs = other.rows[row - dy];
+        for (int word = 0; word < MASK_WORDS; ++word) {
+            if (mine[word] & shiftedWord(theirs, word, dx)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Returns the first fraction of a step in [0, 1] at which this mask, moving
+// from x0 to x1 at y, touches other moving from otherY0 to otherY1 at
+// otherX, or -1 if it never does. The bounds give the part of the step in
+// which the two can touch; within it the masks are compared at whole-pixel
+// positions, at least once for every pixel they move against each other.
+float CollisionMask::sweep(float x0, float x1, float y, const CollisionMask& other, float otherX, float otherY0,
+                           float otherY1) const {
+    // Bounds are widened by a pixel to cover rounding the positions down
+    float enter = 0.0f;
+    float exit = 1.0f;
+    if (!sweepAxis(otherX - x0, otherX - x1, left - other.right - 1.0f, right - other.left + 1.0f, enter, exit) ||
+        !sweepAxis(otherY0 - y, otherY1 - y, top - other.bottom - 1.0f, bottom - other.top + 1.0f, enter, exit)) {
+        return -1.0f;
+    }
+
+    const float travel = std::max(std::abs(x1 - x0), std::abs(otherY1 - otherY0)) * (exit - enter);
+    const int samples = static_cast<int>(std::ceil(travel));
+    const int row = static_cast<int>(std::floor(y));
+    const int otherColumn = static_cast<int>(std::floor(otherX));
+    for (int i = 0; i <= samples; ++i) {
+        const float t = samples == 0 ? enter : enter + (exit - enter) * i / samples;
+        const int column = static_cast<int>(std::floor((1.0f - t) * x0 + t * x1));
+        const int otherRow = static_cast<int>(std::floor((1.0f - t) * otherY0 + t * otherY1));
+        if (overlaps(column, row, other, otherColumn, otherRow)) {
+            return t;
+        }
+    }
+    return -1.0f;
+}
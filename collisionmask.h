@@ -0,0 +1,33 @@
+#ifndef COLLISIONMASK_H
+#define COLLISIONMASK_H
+
+#include <QtGlobal>
+#include "car.h"
+
+#define MASK_WORDS ((CAR_SIZE_X + 63) / 64) // 64-bit words per mask row
+#define MASK_ALPHA_THRESHOLD 128 // Sprite pixels at least this opaque are solid
+
+// Solid pixels of a car sprite scaled into the CAR_SIZE_X x CAR_SIZE_Y box
+// and anchored at its top left, like the drawn sprite. Each row is packed
+// into 64-bit words, column x being bit x % 64 of word x / 64, so two masks
+// are compared a row at a time with a shift and an AND per word.
+// The masks of the car sprites are generated from their alpha channels by
+// assetbake --masks into spritemasks.cpp; regenerate it when they change.
+struct CollisionMask {
+    // Tight bounds of the solid pixels; right and bottom are exclusive
+    int left;
+    int top;
+    int right;
+    int bottom;
+    quint64 rows[CAR_SIZE_Y][MASK_WORDS];
+
+    static const CollisionMask& forSprite(SpriteId id);
+    bool overlaps(int x, int y, const CollisionMask& other, int otherX, int otherY) const;
+    float sweep(float x0, float x1, float y, const CollisionMask& other, float otherX, float otherY0,
+                float otherY1) const;
+
+private:
+    static const CollisionMask bySprite[static_cast<int>(SpriteId::Count)];
+};
+
+#endif // COLLISIONMASK_H
@@ -0,0 +1,41 @@
+# Widget-free game core shared by the application and the benchmarks.
+# Only depends on QtCore.
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/autopilot.cpp \
+    $$PWD/batchenv.cpp \
+    $$PWD/broadphase.cpp \
+    $$PWD/car.cpp \
+    $$PWD/collisionmask.cpp \
+    $$PWD/gamelog.cpp \
+    $$PWD/inputqueue.cpp \
+    $$PWD/particles.cpp \
+    $$PWD/perfstats.cpp \
+    $$PWD/runlog.cpp \
+    $$PWD/scorestore.cpp \
+    $$PWD/simulation.cpp \
+    $$PWD/spawnscheduler.cpp \
+    $$PWD/spritemasks.cpp \
+    $$PWD/trace.cpp \
+    $$PWD/traffic.cpp
+
+HEADERS += \
+    $$PWD/autopilot.h \
+    $$PWD/batchenv.h \
+    $$PWD/broadphase.h \
+    $$PWD/car.h \
+    $$PWD/collisionmask.h \
+    $$PWD/gamelog.h \
+    $$PWD/inputqueue.h \
+    $$PWD/particles.h \
+    $$PWD/perfstats.h \
+    $$PWD/rng.h \
+    $$PWD/runlog.h \
+    $$PWD/scorestore.h \
+    $$PWD/shared.h \
+    $$PWD/simulation.h \
+    $$PWD/spawnscheduler.h \
+    $$PWD/trace.h \
+    $$PWD/traffic.h
@@ -0,0 +1,213 @@
+#include "framecomposer.h"
+#include <QMutexLocker>
+#include <QPainter>
+#include <utility>
+#include "backgroundcache.h"
+#include "gamelog.h"
+#include "shared.h"
+#include "spritecache.h"
+#include "trace.h"
+
+// ===========================
+// FrameComposer Class Implementation
+// ===========================
+
+// Constructor creates an idle composer; call setImages() and start() before submitting
+FrameComposer::FrameComposer(QObject* parent)
+    : QObject(parent),
+    worker(nullptr),
+    hasPending(false),
+    stopping(false),
+    frameWaiting(false),
+    front(0),
+    bufferTicks{0, 0},
+    devicePixelRatio(1.0),
+    blitPath(BlitPath::Painter)
+{
+}
+
+// Destructor joins the worker thread
+FrameComposer::~FrameComposer() {
+    stop();
+}
+
+// Copies the background frames and sprites into images the worker may read.
+// On the raster backend toImage() shares the pixel data instead of copying it.
+// Must be called on the GUI thread while the worker is stopped.
+void FrameComposer::setImages(const BackgroundCache& background, qreal devicePixelRatio) {
+    this->devicePixelRatio = devicePixelRatio;
+
+    backgroundFrames.clear();
+    for (int i = 0; i < background.frameCount(); ++i) {
+        backgroundFrames.append(background.frame(i).toImage());
+    }
+
+    const SpriteCache& sprites = SpriteCache::instance();
+    for (int i = 0; i < static_cast<int>(SpriteId::Count); ++i) {
+        spriteImages[i] = sprites.pixmap(static_cast<SpriteId>(i)).toImage()
+                              .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    }
+
+    // Keep the buffers, and the frame on screen, when only the images changed
+    const QSize pixelSize = QSize(WINDOWS_SIZE_X, WINDOWS_SIZE_Y) * devicePixelRatio;
+    if (buffers[0].size() == pixelSize && buffers[0].devicePixelRatio() == devicePixelRatio) {
+        return;
+    }
+    for (QImage& buffer : buffers) {
+        buffer = QImage(pixelSize, QImage::Format_ARGB32_Premultiplied);
+        buffer.setDevicePixelRatio(devicePixelRatio);
+        buffer.fill(Qt::darkGray);
+    }
+    front = 0;
+    frameWaiting = false;
+}
+
+// Selects how sprites are drawn; must be called while the worker is stopped
+void FrameComposer::setBlitPath(BlitPath path) {
+    blitPath = path;
+    LOG_INFO(Render, "Frame composer blit path set to %.0f.", static_cast<int>(path));
+}
+
+// Returns how sprites are drawn
+BlitPath FrameComposer::getBlitPath() const {
+    return blitPath;
+}
+
+// Starts the worker thread
+void FrameComposer::start() {
+    if (worker) {
+        return;
+    }
+    stopping = false;
+    hasPending = false;
+    worker = QThread::create([this]() { run(); });
+    worker->start();
+    LOG_INFO(Render, "Frame composer thread started.");
+}
+
+// Asks the worker to finish its current frame and waits for it to exit
+void FrameComposer::stop() {
+    if (!worker) {
+        return;
+    }
+    {
+        QMutexLocker locker(&mutex);
+        stopping = true;
+        pendingChanged.wakeOne();
+    }
+    worker->wait();
+    delete worker;
+    worker = nullptr;
+    LOG_INFO(Render, "Frame composer thread stopped.");
+}
+
+// Returns true while the worker thread is running
+bool FrameComposer::isRunning() const {
+    return worker != nullptr;
+}
+
+// Hands a snapshot to the worker, replacing any snapshot it has not started yet.
+// The caller's snapshot is swapped with the old one so its storage is reused.
+void FrameComposer::submit(FrameSnapshot& snapshot) {
+    QMutexLocker locker(&mutex);
+    std::swap(pending, snapshot);
+    hasPending = true;
+    pendingChanged.wakeOne();
+}
+
+// Swaps in the newest finished frame, if any, and returns the buffer to present
+// and the simulation tick it shows. The returned image stays untouched by the
+// worker until the next call.
+const QImage& FrameComposer::acquireFrame(quint32* tick) {
+    QMutexLocker locker(&mutex);
+    if (frameWaiting) {
+        front = 1 - front;
+        frameWaiting = false;
+    }
+    if (tick) {
+        *tick = bufferTicks[front];
+    }
+    return buffers[front];
+}
+
+// Worker loop: waits for a snapshot, draws it into the buffer the GUI is not
+// presenting and publishes it
+void FrameComposer::run() {
+    Trace::setThreadName("composer");
+    forever {
+        int back;
+        {
+            QMutexLocker locker(&mutex);
+            while (!hasPending && !stopping) {
+                pendingChanged.wait(&mutex);
+            }
+            if (stopping) {
+                return;
+            }
+            std::swap(composing, pending);
+            hasPending = false;
+
+            // An unpresented frame in the back buffer is stale now; withdraw it so
+            // the GUI keeps presenting the front buffer while it is overwritten
+            frameWaiting = false;
+            back = 1 - front;
+        }
+
+        compose(buffers[back], composing);
+
+        {
+            QMutexLocker locker(&mutex);
+            bufferTicks[back] = composing.tick;
+            frameWaiting = true;
+        }
+        emit frameReady();
+    }
+}
+
+// Draws a snapshot into an image; safe to call from any thread
+void FrameComposer::compose(QImage& target, const FrameSnapshot& snapshot) const {
+    TRACE_SCOPE("render", "compose");
+    if (snapshot.gameOver) {
+        QPainter painter(&target);
+        hud.drawGameOver(&painter, snapshot.finalTime, snapshot.recordTime);
+        return;
+    }
+
+    // Frames still decoding when the images were copied fall back to the last copied one
+    const bool hasBackground = snapshot.backgroundFrame >= 0 && !backgroundFrames.isEmpty();
+    const int backgroundFrame = qMin(snapshot.backgroundFrame, static_cast<int>(backgroundFrames.size()) - 1);
+    if (blitPath == BlitPath::Painter) {
+        QPainter painter(&target);
+
+        // Background frame, or dark gray if the animation did not load
+        if (hasBackground) {
+            painter.drawImage(0, 0, backgroundFrames[backgroundFrame]);
+        } else {
+            painter.fillRect(0, 0, WINDOWS_SIZE_X, WINDOWS_SIZE_Y, Qt::darkGray);
+        }
+
+        // Cars, main car first
+        for (const FrameSnapshot::Sprite& sprite : snapshot.sprites) {
+            painter.drawImage(QPointF(sprite.x, sprite.y), spriteImages[static_cast<int>(sprite.id)]);
+        }
+        particleRenderer.draw(&painter, snapshot.particles);
+
+        hud.drawTimer(&painter, snapshot.elapsedSeconds);
+        return;
+    }
+
+    // Software path: write the pixels directly, then open a painter only for the text
+    if (hasBackground) {
+        SpriteBlitter::copy(target, backgroundFrames[backgroundFrame]);
+    } else {
+        target.fill(Qt::darkGray);
+    }
+    for (const FrameSnapshot::Sprite& sprite : snapshot.sprites) {
+        QPoint position(qRound(sprite.x * devicePixelRatio), qRound(sprite.y * devicePixelRatio));
+        SpriteBlitter::blend(target, spriteImages[static_cast<int>(sprite.id)], position, blitPath);
+    }
+    particleRenderer.blend(target, snapshot.particles, devicePixelRatio);
+
+    QPainter painter(&target);
+    hud.drawTimer(&painter, snapshot.elapsedSeconds);
+}
@@ -0,0 +1,89 @@
+#ifndef FRAMECOMPOSER_H
+#define FRAMECOMPOSER_H
+
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+#include "car.h"
+#include "hud.h"
+#include "particlerenderer.h"
+#include "particles.h"
+#include "spriteblitter.h"
+
+class BackgroundCache;
+
+// Immutable copy of everything a frame shows, taken on the GUI thread after
+// the simulation steps. The worker draws only from this, never from Game.
+struct FrameSnapshot
+{
+    struct Sprite {
+        float x;
+        float y;
+        SpriteId id;
+    };
+
+    quint32 tick = 0; // Simulation tick the frame shows
+    int backgroundFrame = -1; // Index into the composer's background frames, -1 for none
+    QVector<Sprite> sprites; // Main car first, then the on-screen traffic
+    ParticleBatch particles; // Drawn over the cars
+    double elapsedSeconds = 0.0;
+    bool gameOver = false;
+    double finalTime = 0.0;
+    double recordTime = 0.0;
+};
+
+// Composes frames on a worker thread into two QImage back buffers. The GUI
+// thread submits snapshots and blits the newest finished buffer; it never
+// waits for composition. A snapshot that arrives while the worker is busy
+// replaces the one still queued, so the worker always draws the latest state.
+// Images are used instead of pixmaps because pixmaps are GUI-thread only.
+// compose() is also the software rasterizer of the single-threaded path:
+// with a BlitPath other than Painter, sprites are blended by SpriteBlitter.
+class FrameComposer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FrameComposer(QObject* parent = nullptr);
+    ~FrameComposer();
+
+    void setImages(const BackgroundCache& background, qreal devicePixelRatio);
+    void setBlitPath(BlitPath path);
+    BlitPath getBlitPath() const;
+    void start();
+    void stop();
+    bool isRunning() const;
+    void submit(FrameSnapshot& snapshot);
+    const QImage& acquireFrame(quint32* tick = nullptr);
+    void compose(QImage& target, const FrameSnapshot& snapshot) const;
+
+signals:
+    void frameReady();
+
+private:
+    void run();
+
+    QThread* worker;
+    mutable QMutex mutex;
+    QWaitCondition pendingChanged;
+    FrameSnapshot pending; // Latest submitted snapshot, guarded by mutex
+    FrameSnapshot composing; // Snapshot the worker is drawing, owned by the worker
+    bool hasPending;
+    bool stopping;
+    bool frameWaiting; // Back buffer holds a finished frame the GUI has not taken yet
+    int front; // Buffer the GUI thread presents; only changed by acquireFrame()
+    QImage buffers[2];
+    quint32 bufferTicks[2]; // Simulation tick drawn into each buffer
+
+    QVector<QImage> backgroundFrames;
+    QImage spriteImages[static_cast<int>(SpriteId::Count)];
+    qreal devicePixelRatio;
+    BlitPath blitPath; // Fixed while the worker runs
+    mutable Hud hud; // Text cache of whichever thread composes; only one does at a time
+    mutable ParticleRenderer particleRenderer; // Rect lists of whichever thread composes
+};
+
+#endif // FRAMECOMPOSER_H
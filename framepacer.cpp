@@ -0,0 +1,254 @@
+#include "framepacer.h"
+#include <QEvent>
+#include <QScreen>
+#include <algorithm>
+#include <cmath>
+#include "gamelog.h"
+#include "trace.h"
+
+// ===========================
+// FramePacer Class Implementation
+// ===========================
+
+// Constructor creates a stopped pacer in Precise mode at the default refresh rate
+FramePacer::FramePacer(QObject* parent)
+    : QObject(parent),
+    mode(FramePacing::Precise),
+    perfStats(nullptr),
+    active(false),
+    nominalPeriod(0),
+    period(0),
+    renderLead(0),
+    deadline(0),
+    lastDue(0),
+    lastPresented(0),
+    intervalCount(0),
+    nextInterval(0)
+{
+    setRefreshRate(PACER_DEFAULT_RATE);
+    connect(&timer, &QTimer::timeout, this, &FramePacer::onTimeout);
+}
+
+// Selects how frames are driven; a running loop switches at once
+void FramePacer::setMode(FramePacing newMode) {
+    bool running = active;
+    stop();
+    mode = newMode;
+    if (running) {
+        start();
+    }
+}
+
+// Returns the pacing mode
+FramePacing FramePacer::getMode() const {
+    return mode;
+}
+
+// Follows the window the frames are presented in: its update requests in
+// Display mode, and the refresh rate of the screen it is on
+void FramePacer::setWindow(QWindow* newWindow) {
+    if (window == newWindow) {
+        return;
+    }
+    if (window) {
+        window->removeEventFilter(this);
+        disconnect(window.data(), nullptr, this, nullptr);
+    }
+    window = newWindow;
+    if (!window) {
+        return;
+    }
+
+    window->installEventFilter(this);
+    connect(window.data(), &QWindow::screenChanged, this, [this](QScreen* screen) {
+        if (screen) {
+            setRefreshRate(screen->refreshRate());
+        }
+    });
+    if (window->screen()) {
+        setRefreshRate(window->screen()->refreshRate());
+    }
+    if (active && mode == FramePacing::Display) {
+        window->requestUpdate();
+    }
+}
+
+// Sets the statistics the presentation intervals and missed frames go to; nullptr disables
+void FramePacer::setPerfStats(PerfStats* stats) {
+    perfStats = stats;
+}
+
+// Starts emitting frameDue(); the first frame is due at once
+void FramePacer::start() {
+    active = true;
+    lastDue = 0;
+    lastPresented = 0;
+    intervalCount = 0;
+    nextInterval = 0;
+    period = nominalPeriod;
+    renderLead = 0;
+
+    switch (mode) {
+    case FramePacing::Coarse:
+        timer.setTimerType(Qt::CoarseTimer);
+        timer.setSingleShot(false);
+        timer.start(PACER_COARSE_INTERVAL_MS);
+        break;
+    case FramePacing::Precise:
+        timer.setTimerType(Qt::PreciseTimer);
+        timer.setSingleShot(true);
+        deadline = PerfStats::now();
+        timer.start(0);
+        break;
+    case FramePacing::Display:
+        if (window) {
+            window->requestUpdate();
+        }
+        break;
+    }
+    LOG_INFO(Game, "Frame pacing started with a display period of %.2f ms.", period / 1e6);
+}
+
+// Stops emitting frameDue()
+void FramePacer::stop() {
+    active = false;
+    timer.stop();
+}
+
+// Returns true between start() and stop()
+bool FramePacer::isActive() const {
+    return active;
+}
+
+// Emits a timer-driven frame and, in Precise mode, aims the next one a
+// display period later. Slots already missed are skipped, not caught up.
+void FramePacer::onTimeout() {
+    TRACE_SCOPE("pacer", "timer");
+    lastDue = PerfStats::now();
+    emit frameDue();
+    if (!active || mode != FramePacing::Precise) {
+        return;
+    }
+    qint64 now = PerfStats::now();
+    deadline += period;
+    if (deadline < now) {
+        deadline += (now - deadline) / period * period + period;
+    }
+    arm(now);
+}
+
+// Starts the single-shot timer for the current deadline, to the nearest millisecond
+void FramePacer::arm(qint64 now) {
+    timer.start(static_cast<int>(qMax<qint64>(0, (deadline - now + 500000) / 1000000)));
+}
+
+// Emits a frame for each update request of the window in Display mode and
+// asks for the next one, which the platform holds until the next refresh
+bool FramePacer::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == window && event->type() == QEvent::UpdateRequest && active && mode == FramePacing::Display) {
+        TRACE_SCOPE("pacer", "update request");
+        lastDue = PerfStats::now();
+        emit frameDue();
+        if (active) {
+            window->requestUpdate();
+        }
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+// Records that a frame reached the screen. Measures the interval since the
+// previous one and the render time since frameDue(), and in Precise mode
+// aims the next frame at one period after this one minus the render time.
+void FramePacer::framePresented() {
+    if (!active) {
+        return;
+    }
+    qint64 now = PerfStats::now();
+    if (lastPresented > 0) {
+        qint64 interval = now - lastPresented;
+        intervals[nextInterval] = interval;
+        nextInterval = (nextInterval + 1) % PACER_WINDOW;
+        intervalCount = qMin(intervalCount + 1, PACER_WINDOW);
+        if (mode == FramePacing::Display) {
+            updatePeriod();
+        }
+        if (perfStats) {
+            perfStats->record(PerfPhase::Present, interval);
+            if (interval * 2 > period * 3) {
+                perfStats->countMissedFrames(qMax<qint64>(1, (interval + period / 2) / period - 1));
+            }
+        }
+    }
+    lastPresented = now;
+
+    // Rises at once with a slow frame and decays over about sixteen frames
+    if (lastDue > 0) {
+        qint64 lead = now - lastDue;
+        renderLead = lead > renderLead ? lead : renderLead + (lead - renderLead) / 16;
+        renderLead = qMin(renderLead, period / 2);
+    }
+
+    if (mode == FramePacing::Precise) {
+        deadline = now + period - renderLead;
+        arm(now);
+    }
+}
+
+// Returns the display period in nanoseconds
+qint64 FramePacer::getPeriod() const {
+    return period;
+}
+
+// Returns the smoothed time from frameDue() to presentation in nanoseconds
+qint64 FramePacer::getRenderLead() const {
+    return renderLead;
+}
+
+// Takes the period from a screen refresh rate; unknown rates keep the default
+void FramePacer::setRefreshRate(qreal hz) {
+    if (!(hz > 1.0)) {
+        hz = PACER_DEFAULT_RATE;
+    }
+    nominalPeriod = static_cast<qint64>(std::llround(1e9 / hz));
+    period = nominalPeriod;
+}
+
+// Follows the median of the latest intervals once the window is half full.
+// Medians far from the screen's rate mean the frames are not keeping up,
+// so the nominal period is kept and those frames count as missed.
+void FramePacer::updatePeriod() {
+    if (intervalCount < PACER_WINDOW / 2) {
+        return;
+    }
+    qint64 sorted[PACER_WINDOW];
+    std::copy(intervals, intervals + intervalCount, sorted);
+    std::nth_element(sorted, sorted + intervalCount / 2, sorted + intervalCount);
+    qint64 median = sorted[intervalCount / 2];
+    period = median * 2 > nominalPeriod && median * 2 < nominalPeriod * 3 ? median : nominalPeriod;
+}
+
+// Returns the command-line name of a mode
+const char* FramePacer::modeName(FramePacing mode) {
+    switch (mode) {
+    case FramePacing::Coarse: return "coarse";
+    case FramePacing::Precise: return "precise";
+    case FramePacing::Display: return "display";
+    default: return "unknown";
+    }
+}
+
+// Returns the mode with the given command-line name, or Precise if there is none
+FramePacing FramePacer::fromName(const QString& name, bool* ok) {
+    for (FramePacing mode : {FramePacing::Coarse, FramePacing::Precise, FramePacing::Display}) {
+        if (name.compare(QLatin1String(modeName(mode)), Qt::CaseInsensitive) == 0) {
+            if (ok) {
+                *ok = true;
+            }
+            return mode;
+        }
+    }
+    if (ok) {
+        *ok = false;
+    }
+    return FramePacing::Precise;
+}
@@ -0,0 +1,82 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+#include <QWindow>
+#include "perfstats.h"
+
+#define PACER_COARSE_INTERVAL_MS 16 // Interval of the coarse timer loop
+#define PACER_DEFAULT_RATE 60.0 // Refresh rate assumed until the screen reports one
+#define PACER_WINDOW 15 // Presentation intervals the display period is estimated from
+
+// How the frame loop is driven
+enum class FramePacing : unsigned char {
+    Coarse, // Repeating 16 ms coarse timer, free to drift by several milliseconds
+    Precise, // Precise single-shot timer one display period after the last presented frame, minus the render time
+    Display // Window update requests, which Wayland, macOS and eglfs deliver once per display refresh
+};
+
+// Emits frameDue() once per frame in the selected mode and measures the
+// frames that reach the screen. Game calls framePresented() at the end of
+// each paint; the intervals between presentations go to the Present
+// histogram of PerfStats, and an interval covering more than one display
+// period counts the refreshes that showed no new frame as missed.
+// The display period starts from the screen's refresh rate. In Display
+// mode the platform paces the frames, so the period follows the median of
+// the measured intervals; Precise mode uses it to aim each frame so that it
+// is drawn just before the next refresh.
+class FramePacer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FramePacer(QObject* parent = nullptr);
+    void setMode(FramePacing mode);
+    FramePacing getMode() const;
+    void setWindow(QWindow* window); // Needed by Display mode and for the refresh rate
+    void setPerfStats(PerfStats* stats);
+    void start();
+    void stop();
+    bool isActive() const;
+    void framePresented();
+    qint64 getPeriod() const; // Display period in nanoseconds
+    qint64 getRenderLead() const; // Time from frameDue() to presentation in nanoseconds
+
+    static const char* modeName(FramePacing mode);
+    static FramePacing fromName(const QString& name, bool* ok = nullptr);
+
+signals:
+    void frameDue();
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    void onTimeout();
+    void arm(qint64 now);
+    void setRefreshRate(qreal hz);
+    void updatePeriod();
+
+    FramePacing mode;
+    QTimer timer;
+    QPointer<QWindow> window;
+    PerfStats* perfStats;
+    bool active;
+
+    qint64 nominalPeriod; // From the screen's refresh rate
+    qint64 period; // Display period used for pacing and missed frames
+    qint64 renderLead; // Smoothed time from frameDue() to presentation
+    qint64 deadline; // Next frameDue() in Precise mode, on the PerfStats::now() clock
+    qint64 lastDue; // Last frameDue(), or 0
+    qint64 lastPresented; // Last presented frame, or 0 before the first
+
+    // Ring of the latest presentation intervals
+    qint64 intervals[PACER_WINDOW];
+    int intervalCount;
+    int nextInterval;
+};
+
+#endif // FRAMEPACER_H
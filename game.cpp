@@ -1,103 +1,168 @@
 #include "game.h"
-#include <QMovie>
 #include <QPainter>
 #include <QDebug>
 #include <QTimer>
+#include <QRandomGenerator>
+#include <QStandardPaths>
+#include <QDir>
+#include <QJsonObject>
+#include <QLibraryInfo>
+#include <QSysInfo>
+#include <QSettings>
+#include <QDateTime>
+#include <QThread>
+#include "gamelog.h"
+#include "spritecache.h"
+#include "trace.h"
 
 // ===========================
 // Game Class Implementation
 // ===========================
 
 // Constructor initializes the game state and UI components
-Game::Game(QWidget* parent, QTimer* timer)
+Game::Game(QWidget* parent)
     : QWidget(parent),
+    lastFrameTime(0),
+    accumulator(0),
+    interpolation(0.0f),
+    staticBackground(false),
+    paintedBackgroundFrame(-1),
+    composer(new FrameComposer(this)),
+    autopilotEnabled(false),
+    showPerfOverlay(false),
     isGameOver(false),
     showGameOverText(false),
-    recordTime(0.0),
-    finalTime(0.0),
-    settings("YourOrganization", "YourGame"),
-    timer(timer),
-    elapsed(0)
+    recordTime(0.0)
 {
+    // Game is the only widget that paints the play field, and it paints every pixel
+    setFixedSize(WINDOWS_SIZE_X, WINDOWS_SIZE_Y);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
     // Set focus policy to accept key events
     setFocusPolicy(Qt::StrongFocus);
     setFocus(); // Ensure the game widget has focus when the game starts
-    qDebug() << "Game widget initialized and focus set.";
-
-    // Load the record time from persistent storage
-    recordTime = settings.value("recordTime", 0.0).toDouble();
-    qDebug() << "Loaded recordTime:" << recordTime;
-
-    // Connect the timer to the updateGame slot
-    connect(timer, &QTimer::timeout, this, &Game::updateGame);
-    timer->start(16); // Approximately 60 FPS
-    qDebug() << "Timer started with interval 16ms.";
-
-    // Start the elapsed timer
-    ecTimer.start();
-    qDebug() << "Elapsed timer started.";
-
-    // Initialize game level
-    level = 2;
-    qDebug() << "Initial game level set to:" << level;
-
-    // Initialize main car position
-    mainCar.setX((WINDOWS_SIZE_X - CAR_SIZE_X) / 2); // Centered horizontally
-    mainCar.setY(WINDOWS_SIZE_Y - CAR_SIZE_Y - 20); // Positioned near the bottom
-    qDebug() << "Main car initialized at (" << mainCar.getX() << "," << mainCar.getY() << ")";
+    LOG_INFO(Game, "Game widget initialized and focus set.");
+
+    // Open the run history; the leaderboards come from its index, not from a scan
+    scores.open(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation));
+    if (scores.getRunCount() == 0) {
+        // Carry over the single best time kept by earlier versions
+        QSettings legacy("YourOrganization", "YourGame");
+        double legacyRecord = legacy.value("recordTime", 0.0).toDouble();
+        if (legacyRecord > 0.0) {
+            scores.submit(ScoreStore::makeRecord(legacyRecord, 0, 0, QDateTime::currentMSecsSinceEpoch()));
+        }
+    }
+    recordTime = scores.getBoard().bestTime();
+    LOG_INFO(Game, "Loaded recordTime: %.2f", recordTime);
 
-    // Load car images
-    mainCar.loadImage(":/img/car_image.png", CAR_SIZE_X, CAR_SIZE_Y); // Main car
-    secondaryCar1.loadImage(":/img/secondary_car2.png", CAR_SIZE_X, CAR_SIZE_Y); // Secondary cars
-    secondaryCar2.loadImage(":/img/secondary_car2.png", CAR_SIZE_X, CAR_SIZE_Y);
-    secondaryCar3.loadImage(":/img/secondary_car2.png", CAR_SIZE_X, CAR_SIZE_Y);
+    // Time the spawn and collision phases inside each step
+    simulation.setPerfStats(&perfStats);
 
-    // Initialize random seed
-    srand(static_cast<unsigned int>(time(0)));
-    qDebug() << "Random seed initialized.";
+    // Resolve the car sprites once; cars only carry a SpriteId
+    QElapsedTimer assetTimer;
+    assetTimer.start();
+    SpriteCache::instance().preload(devicePixelRatioF());
+    qint64 spriteNs = assetTimer.nsecsElapsed();
 
-    // Set initial positions for secondary cars in different lanes
-    initializeCarPositions();
+    // Start the first run with a fresh seed
+    beginRun();
 
     // Load animated background
+    assetTimer.restart();
     loadBackground();
+#ifndef QT_NO_DEBUG
+    qDebug("Startup: sprites %.1f ms, first background frame %.1f ms",
+           spriteNs / 1e6, assetTimer.nsecsElapsed() / 1e6);
+#else
+    Q_UNUSED(spriteNs);
+#endif
 
     // Initialize Restart Button
     initializeRestartButton();
+
+    // Finished off-thread frames are presented by a normal repaint
+    connect(composer, &FrameComposer::frameReady, this, QOverload<>::of(&Game::update));
+
+    // Every paced frame runs updateGame; the pacer also measures the presented frames
+    pacer.setPerfStats(&perfStats);
+    connect(&pacer, &FramePacer::frameDue, this, &Game::updateGame);
+    startLoop();
 }
 
-// Destructor cleans up the background movie
+// Destructor writes the performance summary of a run that is still in
+// progress, and the trace if tracing is on
 Game::~Game() {
-    if (background) {
-        background->stop();
-        delete background;
-        qDebug() << "Background movie stopped and deleted.";
+    if (!isGameOver) {
+        writePerfSummary();
+    }
+    if (Trace::isEnabled()) {
+        writeTrace();
     }
 }
 
-// Initializes the positions of the secondary cars in different lanes
-void Game::initializeCarPositions() {
-    secondaryCar1.setX(WINDOWS_SIZE_X - CAR_SIZE_X - 15); // Right lane
-    secondaryCar1.setY(-CAR_SIZE_Y - (rand() % 800) + 2000); // Random Y within bounds
-    qDebug() << "SecondaryCar1 initialized at (" << secondaryCar1.getX() << "," << secondaryCar1.getY() << ")";
+// Resets the simulation with a fresh seed and starts recording the run
+void Game::beginRun() {
+    perfStats.clear();
+    simulation.reset(QRandomGenerator::global()->generate64());
+    runLog.begin(simulation.getSeed(), SIM_STEP_MS, simulation.getTraffic().getLaneCount(),
+                 simulation.getTraffic().size(), simulation.getLaneChangeTicks());
+    LOG_INFO(Game, "Run started with seed %.0f * 2^32 + %.0f.", static_cast<quint32>(simulation.getSeed() >> 32),
+             static_cast<quint32>(simulation.getSeed()));
+}
 
-    secondaryCar2.setX(15); // Left lane
-    secondaryCar2.setY(-CAR_SIZE_Y - (rand() % 800) + 2000); // Random Y within bounds
-    qDebug() << "SecondaryCar2 initialized at (" << secondaryCar2.getX() << "," << secondaryCar2.getY() << ")";
+// Starts the frame pacer and the clock that feeds the fixed-step accumulator
+void Game::startLoop() {
+    lastFrameTime = 0;
+    accumulator = 0;
+    interpolation = 0.0f;
+    ecTimer.start();
+    pacer.start(); // Frame rate only; the simulation rate is independent of it
+    LOG_INFO(Game, "Frame loop started.");
+}
 
-    secondaryCar3.setX((WINDOWS_SIZE_X - CAR_SIZE_X) / 2 - 10); // Center lane
-    secondaryCar3.setY(-CAR_SIZE_Y - (rand() % 800) + 2000); // Random Y within bounds
-    qDebug() << "SecondaryCar3 initialized at (" << secondaryCar3.getX() << "," << secondaryCar3.getY() << ")";
+// Hands the window the game is shown in to the pacer, for its refresh rate
+// and, in Display mode, its update requests
+void Game::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    pacer.setWindow(window()->windowHandle());
 }
 
-// Loads the animated background GIF
+// Starts decoding the animated background GIF into the pre-scaled frame cache
 void Game::loadBackground() {
-    background = new QMovie(":/img/background.gif"); // Update path if needed
-    if (!background->isValid()) {
-        qDebug() << "Failed to load background GIF!";
+    if (!background.load(":/img/background.gif", QSize(WINDOWS_SIZE_X, WINDOWS_SIZE_Y), devicePixelRatioF())) {
+        qWarning() << "Failed to load background GIF!";
     } else {
-        background->start(); // Start the animation
-        qDebug() << "Background GIF loaded and animation started.";
+        LOG_INFO(Game, "Background GIF first frame ready; the rest decode in the background.");
+    }
+
+    // The composer keeps its own image copies of the frames
+    if (composer->isRunning() || composer->getBlitPath() != BlitPath::Painter) {
+        refreshComposerImages();
+    }
+}
+
+// Adds background frames and sprites decoded off the GUI thread. The
+// composer gets its copies once the whole animation is in.
+void Game::collectLoadedAssets() {
+    TRACE_SCOPE("assets", "collectLoadedAssets");
+    SpriteCache::instance().collectLoaded();
+    if (!background.isLoading()) {
+        return;
+    }
+    background.collectLoadedFrames();
+    if (!background.isLoading() && (composer->isRunning() || composer->getBlitPath() != BlitPath::Painter)) {
+        refreshComposerImages();
+    }
+}
+
+// Recopies the background and sprites into the composer, pausing its worker if needed
+void Game::refreshComposerImages() {
+    bool running = composer->isRunning();
+    composer->stop();
+    composer->setImages(background, devicePixelRatioF());
+    if (running) {
+        composer->start();
     }
 }
 
@@ -110,354 +175,639 @@ void Game::initializeRestartButton() {
 
     // Position the button at the upper right corner
     restartButton->move(0,0);
-    qDebug() << "Restart button positioned at (" << restartButton->x() << "," << restartButton->y() << ")";
+    LOG_INFO(Game, "Restart button positioned at (%.0f, %.0f)", restartButton->x(), restartButton->y());
 
     // Set button styles
     restartButton->setStyleSheet("background-color: white; color: black;");
     restartButton->hide(); // Hide the button initially
-    qDebug() << "Restart button initialized and hidden.";
+    LOG_INFO(Game, "Restart button initialized and hidden.");
 
     // Connect the button's clicked signal to the restartGame slot
     connect(restartButton, &QPushButton::clicked, this, &Game::restartGame);
-    qDebug() << "Restart button connected to restartGame slot.";
+    LOG_INFO(Game, "Restart button connected to restartGame slot.");
 }
 
-// Handles the paint event by delegating to the render function
+// Handles the paint event by delegating to the render function, or by
+// blitting the newest frame composed off-thread
 void Game::paintEvent(QPaintEvent* event) {
     Q_UNUSED(event);
+    TRACE_SCOPE("render", "paintEvent");
+    qint64 start = PerfStats::now();
     QPainter painter(this);
-    render(&painter);
-    qDebug() << "paintEvent triggered and render function called.";
-}
+    quint32 shownTick = simulation.getTick();
+    if (composer->isRunning()) {
+        painter.drawImage(0, 0, composer->acquireFrame(&shownTick));
+        LOG_TRACE(Render, "paintEvent presented the composed frame.");
+    } else {
+        render(&painter);
+        LOG_TRACE(Render, "paintEvent triggered and render function called.");
+    }
+
+    // The overlay is drawn on top of every render path and is not part of the timing
+    perfStats.record(PerfPhase::Render, PerfStats::now() - start);
+    if (showPerfOverlay && !showGameOverText) {
+        hud.drawPerfOverlay(&painter, perfStats);
+    }
+    painter.end();
 
-// Checks if the player's X position is within the game window boundaries
-bool Game::inRange(int playerX) {
-    bool range = (playerX >= 0) && ((playerX + CAR_SIZE_X) <= WINDOWS_SIZE_X);
-    qDebug() << "Checking if player X:" << playerX << "is in range:" << range;
-    return range;
+#ifndef QT_NO_DEBUG
+    // Time to first frame, from the start of main() to the end of the first paint
+    if (startupClock.isValid()) {
+        qDebug("Startup: first frame after %.1f ms", startupClock.nsecsElapsed() / 1e6);
+        startupClock.invalidate();
+    }
+#endif
+
+    // The frame is as good as on screen; this paces the next one
+    pacer.framePresented();
+
+    // Key presses whose tick is on screen now. The backing store is flushed
+    // right after this, so the end of the paint is the closest portable
+    // stand-in for the photon.
+    if (!latencyProbes.isEmpty()) {
+        qint64 shownAt = ecTimer.nsecsElapsed();
+        while (!latencyProbes.isEmpty() && latencyProbes.first().tick <= shownTick) {
+            perfStats.record(PerfPhase::InputToPhoton, shownAt - latencyProbes.first().timestamp);
+            latencyProbes.removeFirst();
+        }
+    }
 }
 
 // Handles key press events for left and right arrow keys
 void Game::keyPressEvent(QKeyEvent* event) {
-    qDebug() << "Key pressed:" << event->key();
+    LOG_DEBUG(Input, "Key pressed: %.0f", event->key());
 
-    // If the game is over, ignore key presses
-    if (isGameOver) {
-        qDebug() << "Game is over. Ignoring key press.";
+    // Dump the in-memory log on demand
+    if (event->key() == Qt::Key_F12) {
+        GameLog::dump(stderr);
         return;
     }
 
-    // Handle left arrow key press
-    if (event->key() == Qt::Key_Left) {
-        if (inRange(mainCar.getX() - MOVING_STEP)) {
-            mainCar.moveX(-MOVING_STEP); // Move left
-            qDebug() << "Moved main car left to X:" << mainCar.getX();
+    // Start tracing, or write what has been traced so far
+    if (event->key() == Qt::Key_F9) {
+        if (Trace::isEnabled()) {
+            writeTrace();
         } else {
-            qDebug() << "Move left out of range.";
-        }
-    }
-    // Handle right arrow key press
-    else if (event->key() == Qt::Key_Right) {
-        if (inRange(mainCar.getX() + MOVING_STEP)) {
-            mainCar.moveX(MOVING_STEP); // Move right
-            qDebug() << "Moved main car right to X:" << mainCar.getX();
-        } else {
-            qDebug() << "Move right out of range.";
+            Trace::setEnabled(true);
+            LOG_INFO(Game, "Tracing started.");
         }
+        return;
     }
-}
 
-// Checks for collisions between the main car and any secondary cars
-bool Game::checkCollision() {
-    const int padding = 30; // Padding to make collision detection less strict
+    // Toggle the performance overlay
+    if (event->key() == Qt::Key_F3) {
+        showPerfOverlay = !showPerfOverlay;
+        update();
+        return;
+    }
 
-    // Define rectangles for collision detection with padding
-    QRect mainCarRect(mainCar.getX(), mainCar.getY(), CAR_SIZE_X - padding, CAR_SIZE_Y - padding);
-    QRect secondaryCar1Rect(secondaryCar1.getX(), secondaryCar1.getY(), CAR_SIZE_X - padding, CAR_SIZE_Y - padding);
-    QRect secondaryCar2Rect(secondaryCar2.getX(), secondaryCar2.getY(), CAR_SIZE_X - padding, CAR_SIZE_Y - padding);
-    QRect secondaryCar3Rect(secondaryCar3.getX(), secondaryCar3.getY(), CAR_SIZE_X - padding, CAR_SIZE_Y - padding);
+    // If the game is over, ignore key presses
+    if (isGameOver) {
+        LOG_DEBUG(Input, "Game is over. Ignoring key press.");
+        return;
+    }
 
-    // Check intersection with any secondary car
-    bool collision = mainCarRect.intersects(secondaryCar1Rect) ||
-                     mainCarRect.intersects(secondaryCar2Rect) ||
-                     mainCarRect.intersects(secondaryCar3Rect);
+    // Hand steering to the autopilot, or take it back
+    if (event->key() == Qt::Key_A) {
+        autopilotEnabled = !autopilotEnabled;
+        LOG_INFO(Input, "Autopilot %.0f.", autopilotEnabled);
+        return;
+    }
 
-    qDebug() << "Collision check result:" << collision;
-    return collision;
+    // Presses are queued with their arrival time and applied on tick boundaries
+    if (event->key() == Qt::Key_Left || event->key() == Qt::Key_Right) {
+        autopilotEnabled = false;
+        int steer = event->key() == Qt::Key_Left ? -1 : 1;
+        if (inputQueue.push(ecTimer.nsecsElapsed(), steer)) {
+            LOG_DEBUG(Input, "Queued move %.0f.", steer);
+        } else {
+            LOG_DEBUG(Input, "Input queue full; dropped move %.0f.", steer);
+        }
+    }
 }
 
 // Handles key release events (currently no action needed)
 void Game::keyReleaseEvent(QKeyEvent* event) {
     Q_UNUSED(event);
-    qDebug() << "Key released:" << event->key();
+    LOG_DEBUG(Input, "Key released: %.0f", event->key());
     // Currently, no action needed on key release
 }
 
-// Validates the positions of secondary cars to ensure they aren't too close vertically
-bool Game::isValidPosition(int padding) {
-    bool valid = !(abs(secondaryCar1.getY() - secondaryCar2.getY()) < 2 * CAR_SIZE_Y + padding &&
-                   abs(secondaryCar2.getY() - secondaryCar3.getY()) < 2 * CAR_SIZE_Y + padding);
-    qDebug() << "Checking valid positions with padding" << padding << ":" << valid;
-    return valid;
-}
-
 // Main game update loop called periodically by the timer
 void Game::updateGame() {
-    qDebug() << "updateGame called.";
+    TRACE_SCOPE("game", "updateGame");
+    LOG_TRACE(Game, "updateGame called.");
+
+    // Accumulate the real time since the previous frame
+    qint64 now = ecTimer.nsecsElapsed();
+    const qint64 frameNs = now - lastFrameTime;
+    lastFrameTime = now;
 
-    // If the game is over, do not update the game state
+    // After a crash only the particles move; the loop stops once they have
+    // settled or the game over screen covers them
     if (isGameOver) {
-        qDebug() << "Game is over. updateGame will not proceed.";
+        if (!showGameOverText && particles.size() > 0) {
+            updateParticles(qMin(frameNs / 1e9f, PARTICLE_MAX_FRAME_SECONDS));
+            requestFrame();
+        } else {
+            pacer.stop();
+            LOG_TRACE(Game, "Game is over. updateGame will not proceed.");
+        }
         return;
     }
 
-    // Update level based on elapsed time to increase difficulty
-    level = 3 + 2 * elapsed / 10000;
-    qDebug() << "Game level updated to:" << level;
+    // Take over assets the loader threads have finished since the last frame
+    collectLoadedAssets();
 
-    // Move the secondary cars downward based on the current level (speed)
-    secondaryCar1.updateCar(level);
-    secondaryCar2.updateCar(level);
-    secondaryCar3.updateCar(level);
+    accumulator += frameNs;
+    perfStats.record(PerfPhase::Frame, frameNs);
 
-    // Ensure cars are in valid positions to avoid overlapping lanes
-    while (!isValidPosition(350)) { // Increased padding for better spacing
-        qDebug() << "Invalid car positions detected. Resetting positions.";
-        // Find the car with the smallest Y (highest on the screen)
-        if (secondaryCar1.getY() <= secondaryCar2.getY() && secondaryCar1.getY() <= secondaryCar3.getY()) {
-            // Move secondaryCar1 to a new random Y-position above the screen
-            secondaryCar1.setY(-CAR_SIZE_Y - (rand() % 800) - 400);
-            qDebug() << "SecondaryCar1 position reset to Y:" << secondaryCar1.getY();
+    // Clamp long stalls (debugger, suspended window) instead of replaying them all at once
+    const qint64 stepNs = SIM_STEP_MS * 1000000LL;
+    const qint64 maxBacklogNs = 25 * stepNs;
+    if (accumulator > maxBacklogNs) {
+        perfStats.countDroppedTicks((accumulator - maxBacklogNs) / stepNs);
+        accumulator = maxBacklogNs;
+    }
+
+    // Run as many fixed steps as the elapsed time covers; a step is late if a
+    // whole further step was already due when it ran
+    while (accumulator >= stepNs && !simulation.isCrashed()) {
+        // This step covers game time up to tickDue; it takes one press that arrived by then
+        const qint64 tickDue = now - accumulator + stepNs;
+        SimInput input;
+        InputEvent event;
+        qint64 inputTime = 0;
+        if (inputQueue.takeUntil(tickDue, event)) {
+            input.steer = event.steer;
+            inputTime = event.timestamp;
+            perfStats.record(PerfPhase::InputToTick, ecTimer.nsecsElapsed() - event.timestamp);
         }
-        else if (secondaryCar2.getY() <= secondaryCar1.getY() && secondaryCar2.getY() <= secondaryCar3.getY()) {
-            // Move secondaryCar2 to a new random Y-position above the screen
-            secondaryCar2.setY(-CAR_SIZE_Y - (rand() % 800) - 400);
-            qDebug() << "SecondaryCar2 position reset to Y:" << secondaryCar2.getY();
+
+        // The autopilot steers through the same path as the keys, so its runs replay too
+        if (autopilotEnabled && Autopilot::isDecisionTick(simulation.getTick())) {
+            TRACE_SCOPE("game", "autopilot");
+            input.steer = autopilot.decide(simulation);
+            inputTime = tickDue;
         }
-        else {
-            // Move secondaryCar3 to a new random Y-position above the screen
-            secondaryCar3.setY(-CAR_SIZE_Y - (rand() % 800) - 400);
-            qDebug() << "SecondaryCar3 position reset to Y:" << secondaryCar3.getY();
+        if (input.steer != 0) {
+            runLog.record(simulation.getTick(), static_cast<quint32>(inputTime / 1000000), input.steer);
+        }
+
+        qint64 tickStart = PerfStats::now();
+        simulation.step(SIM_STEP_MS, input);
+        qint64 tickEnd = PerfStats::now();
+        perfStats.record(PerfPhase::Tick, tickEnd - tickStart);
+        Trace::record("sim", "tick", tickStart, tickEnd);
+        perfStats.countTick(accumulator >= 2 * stepNs);
+        accumulator -= stepNs;
+
+        // Measure until the first frame that shows this tick is painted
+        if (input.steer != 0 && !autopilotEnabled) {
+            latencyProbes.append(LatencyProbe{event.timestamp, simulation.getTick()});
         }
     }
+    interpolation = static_cast<float>(accumulator) / stepNs;
+
+    // Particles follow the frame, not the simulation steps, and never affect a run
+    updateParticles(qMin(frameNs / 1e9f, PARTICLE_MAX_FRAME_SECONDS));
 
     // Check for collision between the main car and any secondary car
-    if (checkCollision()) {
-        qDebug() << "Collision detected! Stopping the game.";
+    if (simulation.isCrashed()) {
+        onCrash();
+        return; // Exit the updateGame method as the game is now over
+    }
+
+    // Trigger a repaint of whatever changed
+    scheduleRepaint();
+    LOG_TRACE(Game, "UI repaint triggered.");
+}
+
+// Emits exhaust behind the traffic on screen and advances every particle
+// by the frame time
+void Game::updateParticles(float seconds) {
+    TRACE_SCOPE("game", "particles");
+    if (!isGameOver) {
+        const int puffs = particles.exhaustDue(seconds);
+        const Traffic& traffic = simulation.getTraffic();
+        const float roadSpeed = static_cast<float>(simulation.getLevel() * SPEED_PER_LEVEL);
+        for (int i = 0; puffs > 0 && i < traffic.size(); ++i) {
+            float carY = traffic.getRenderY(i, interpolation);
+            if (carY > WINDOWS_SIZE_Y || carY + CAR_SIZE_Y < 0) {
+                continue;
+            }
+
+            // Traffic is oncoming and faces the player, so its tailpipe is at the top
+            particles.emitExhaust(traffic.getX(i) + CAR_SIZE_X / 2.0f, carY, roadSpeed, puffs);
+        }
+    }
+    particles.update(seconds);
+}
 
-        // Stop the game timer to halt further updates
-        timer->stop();
-        qDebug() << "Timer stopped.";
+// Returns the animation time of the background, tied to the road distance
+qint64 Game::backgroundTime() const {
+    if (staticBackground) {
+        return 0;
+    }
+    return static_cast<qint64>(simulation.getRoadDistance() * 1000.0 / BACKGROUND_BASE_SPEED);
+}
 
-        // Disconnect the timer signal to prevent further calls to updateGame
-        disconnect(timer, &QTimer::timeout, this, &Game::updateGame);
-        qDebug() << "Timer signal disconnected from updateGame slot.";
+// Collects the screen rects of everything that moves or changes between frames
+void Game::collectDirtyRects(QVector<QRect>& rects) const {
+    const Car& mainCar = simulation.getMainCar();
+    rects.append(QRectF(mainCar.getX(), mainCar.getY(), CAR_SIZE_X, CAR_SIZE_Y).toAlignedRect());
 
-        // Load the crashed car image to indicate the collision visually
-        if (!mainCar.isNull()) { // Ensure the car image is valid before loading
-            mainCar.loadImage(":/img/crashed_car.png", CAR_SIZE_X, CAR_SIZE_Y);
-            qDebug() << "Crashed car image loaded.";
-        } else {
-            qDebug() << "Failed to load crashed car image!";
+    const Traffic& traffic = simulation.getTraffic();
+    for (int i = 0; i < traffic.size(); ++i) {
+        float carY = traffic.getRenderY(i, interpolation);
+        if (carY > WINDOWS_SIZE_Y || carY + CAR_SIZE_Y < 0) {
+            continue;
         }
+        rects.append(QRectF(traffic.getX(i), carY, CAR_SIZE_X, CAR_SIZE_Y).toAlignedRect());
+    }
+
+    // Particles move every frame; one rect around all of them
+    if (particles.size() > 0) {
+        rects.append(particles.getBatch().bounds().toAlignedRect());
+    }
+
+    // HUD timer box and the performance overlay below it
+    rects.append(HUD_TIMER_RECT);
+    if (showPerfOverlay) {
+        rects.append(HUD_PERF_RECT);
+    }
+}
+
+// Repaints only the old and new sprite rects while the background frame is
+// unchanged; any background change repaints the whole widget
+void Game::scheduleRepaint() {
+    // Composed frames cover the whole widget
+    if (composer->isRunning()) {
+        requestFrame();
+        return;
+    }
 
-        // Record the final time in seconds
-        finalTime = elapsed / 1000.0; // Convert milliseconds to seconds
-        qDebug() << "Final time recorded:" << finalTime << "seconds.";
+    int backgroundFrame = background.frameIndexAt(backgroundTime());
+    frameRects.clear();
+    collectDirtyRects(frameRects);
 
-        // Update the record time if the current time is greater
-        if (finalTime > recordTime) {
-            recordTime = finalTime;
-            settings.setValue("recordTime", recordTime); // Save the new record time persistently
-            qDebug() << "New record time set:" << recordTime << "seconds.";
+    if (backgroundFrame != paintedBackgroundFrame || showGameOverText) {
+        update();
+    } else {
+        // Qt merges the rects into its own dirty region; building a QRegion here would allocate
+        for (const QRect& rect : paintedRects) {
+            update(rect);
         }
+        for (const QRect& rect : frameRects) {
+            update(rect);
+        }
+    }
+
+    paintedRects.swap(frameRects);
+    paintedBackgroundFrame = backgroundFrame;
+}
+
+// Sets the clock started in main() that debug builds report the time to first frame against
+void Game::setStartupClock(const QElapsedTimer& clock) {
+    startupClock = clock;
+}
+
+// Moves the car between lanes over a few ticks instead of teleporting.
+// Takes effect with the next run so a recorded run keeps one setting.
+void Game::setSmoothLaneChange(bool enabled) {
+    simulation.setLaneChangeTicks(enabled ? SMOOTH_LANE_CHANGE_TICKS : 0);
+    runLog.begin(simulation.getSeed(), SIM_STEP_MS, simulation.getTraffic().getLaneCount(),
+                 simulation.getTraffic().size(), simulation.getLaneChangeTicks());
+}
+
+// Freezes or resumes the road animation; a frozen road allows dirty-region repaints
+void Game::setStaticBackground(bool enabled) {
+    staticBackground = enabled;
+    paintedBackgroundFrame = -1; // Force the next repaint to cover the whole widget
+    requestFrame();
+}
+
+// Moves frame composition to a worker thread, or back to paintEvent
+void Game::setThreadedRendering(bool enabled) {
+    if (enabled == composer->isRunning()) {
+        return;
+    }
+    if (enabled) {
+        composer->setImages(background, devicePixelRatioF());
+        composer->start();
+    } else {
+        composer->stop();
+    }
+    requestFrame();
+}
+
+// Selects how frames are rasterized: QPainter, or SpriteBlitter with a
+// scalar or SIMD kernel. Unsupported kernels fall back to the best one.
+void Game::setBlitPath(BlitPath path) {
+    if (!SpriteBlitter::isSupported(path)) {
+        qWarning() << "Blit path" << SpriteBlitter::name(path) << "is not supported on this CPU, using"
+                   << SpriteBlitter::name(SpriteBlitter::bestPath());
+        path = SpriteBlitter::bestPath();
+    }
+
+    // The composer may only change paths while its worker is paused
+    bool running = composer->isRunning();
+    composer->stop();
+    composer->setBlitPath(path);
+    composer->setImages(background, devicePixelRatioF());
+    if (running) {
+        composer->start();
+    }
+    requestFrame();
+}
 
-        // Immediately update the UI to show the crashed car
+// Selects how the frame loop is driven: a coarse 16 ms timer, a precise
+// timer aimed at the display refresh, or the window's update requests
+void Game::setFramePacing(FramePacing mode) {
+    pacer.setMode(mode);
+    LOG_INFO(Game, "Frame pacing set to mode %.0f.", static_cast<int>(mode));
+}
+
+// Repaints the whole widget; with threaded rendering the repaint follows
+// once the worker has composed the current state
+void Game::requestFrame() {
+    if (composer->isRunning()) {
+        captureSnapshot(snapshot);
+        composer->submit(snapshot);
+    } else {
         update();
-        qDebug() << "UI updated to show crashed car.";
-
-        // Set the game over flag to true to prevent further game updates
-        isGameOver = true;
-        qDebug() << "Game over flag set to true.";
-
-        // Schedule the "Game Over" message to appear after a 2-second delay without blocking the main thread
-        QTimer::singleShot(2000, this, [this]() {
-            showGameOverText = true; // Flag to display the "Game Over" message
-            update(); // Trigger a repaint to show "Game Over"
-            restartButton->show(); // Show the Restart Button
-            qDebug() << "Game Over message displayed and Restart button shown.";
-            this->setFocus();      // Set focus back to the game widget
-            qDebug() << "Focus set back to game widget.";
-        });
+    }
+}
 
-        return; // Exit the updateGame method as the game is now over
+// Copies the state the next frame shows, with traffic interpolated and culled
+void Game::captureSnapshot(FrameSnapshot& frame) const {
+    frame.tick = simulation.getTick();
+    frame.backgroundFrame = background.frameIndexAt(backgroundTime());
+    frame.elapsedSeconds = simulation.getElapsed() / 1000.0;
+    frame.gameOver = showGameOverText;
+    frame.finalTime = simulation.getFinalTime();
+    frame.recordTime = recordTime;
+
+    frame.particles.copyFrom(particles.getBatch());
+
+    frame.sprites.clear();
+    const Car& mainCar = simulation.getMainCar();
+    frame.sprites.append({static_cast<float>(mainCar.getX()), mainCar.getY(), mainCar.getSprite()});
+
+    const Traffic& traffic = simulation.getTraffic();
+    for (int i = 0; i < traffic.size(); ++i) {
+        float carY = traffic.getRenderY(i, interpolation);
+        if (carY > WINDOWS_SIZE_Y || carY + CAR_SIZE_Y < 0) {
+            continue;
+        }
+        frame.sprites.append({static_cast<float>(traffic.getX(i)), carY, traffic.getSprite(i)});
     }
+}
 
-    // Update the elapsed time based on the QElapsedTimer
-    elapsed = ecTimer.elapsed();
-    qDebug() << "Elapsed time updated:" << elapsed << "milliseconds.";
+// Handles the UI side of a collision detected by the simulation
+void Game::onCrash() {
+    TRACE_SCOPE("game", "onCrash");
+    LOG_INFO(Game, "Collision detected! Stopping the game.");
+
+    // Show the cars exactly where the collision was detected
+    interpolation = 1.0f;
+
+    // Debris and smoke at the front of the player's car. The frame pacer
+    // keeps running until they have settled; see updateGame().
+    const Car& mainCar = simulation.getMainCar();
+    particles.emitCrash(mainCar.getX() + CAR_SIZE_X / 2.0f, mainCar.getY() + CAR_SIZE_Y / 8.0f);
+
+    // Keep the run log so the run can be replayed, and the timings for comparison
+    saveRunLog();
+    writePerfSummary();
+
+    // Queue the run for the score store; the disk write happens on its writer thread
+    double finalTime = simulation.getFinalTime();
+    scores.submit(ScoreStore::makeRecord(finalTime, simulation.getSeed(), simulation.getLevel(),
+                                         QDateTime::currentMSecsSinceEpoch()));
+    if (finalTime > recordTime) {
+        recordTime = finalTime;
+        LOG_INFO(Game, "New record time set: %.2f seconds.", recordTime);
+    }
 
-    // Trigger a repaint to update the game's visuals
-    update();
-    qDebug() << "UI repaint triggered.";
+    // Immediately update the UI to show the crashed car; the simulation already swapped its sprite
+    requestFrame();
+    LOG_INFO(Game, "UI updated to show crashed car.");
+
+    // Set the game over flag to true to prevent further game updates
+    isGameOver = true;
+    LOG_INFO(Game, "Game over flag set to true.");
+
+    // Schedule the "Game Over" message to appear after a 2-second delay without blocking the main thread
+    QTimer::singleShot(2000, this, [this]() {
+        showGameOverText = true; // Flag to display the "Game Over" message
+        requestFrame(); // Trigger a repaint to show "Game Over"
+        restartButton->show(); // Show the Restart Button
+        LOG_INFO(Game, "Game Over message displayed and Restart button shown.");
+        this->setFocus();      // Set focus back to the game widget
+        LOG_INFO(Game, "Focus set back to game widget.");
+    });
+}
+
+// Writes the finished run to the app data directory as last_run.runlog
+void Game::saveRunLog() {
+    RunOutcome outcome;
+    outcome.crashed = simulation.isCrashed();
+    outcome.crashTick = simulation.getTick();
+    outcome.playerLane = simulation.getPlayerLane();
+    outcome.elapsed = simulation.getElapsed();
+    runLog.finish(outcome);
+
+    QString directory = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(directory);
+    QString path = directory + "/last_run.runlog";
+    if (runLog.save(path)) {
+        LOG_INFO(Game, "Run log saved with %.0f events.", runLog.getEvents().size());
+    }
+}
+
+// Writes the timings of the current run with machine and build details to
+// the app data directory as perf_summary.json
+void Game::writePerfSummary() {
+    if (perfStats.getTicks() == 0) {
+        return;
+    }
+
+#ifdef QT_NO_DEBUG
+    const bool debugBuild = false;
+#else
+    const bool debugBuild = true;
+#endif
+
+    QJsonObject context;
+    context["machine"] = QJsonObject{
+        {"os", QSysInfo::prettyProductName()},
+        {"cpu_architecture", QSysInfo::currentCpuArchitecture()},
+        {"ideal_threads", QThread::idealThreadCount()},
+    };
+    context["build"] = QJsonObject{
+        {"qt", QLibraryInfo::build()},
+        {"compiled_with", QT_VERSION_STR},
+        {"debug", debugBuild},
+    };
+    context["settings"] = QJsonObject{
+        {"lanes", simulation.getTraffic().getLaneCount()},
+        {"traffic", simulation.getTraffic().size()},
+        {"blit_path", SpriteBlitter::name(composer->getBlitPath())},
+        {"threaded_rendering", composer->isRunning()},
+        {"static_background", staticBackground},
+        {"device_pixel_ratio", devicePixelRatioF()},
+        {"frame_pacing", FramePacer::modeName(pacer.getMode())},
+        {"display_period_us", pacer.getPeriod() / 1000.0},
+    };
+    context["run"] = QJsonObject{
+        {"seed", QString::number(simulation.getSeed())},
+        {"ticks", static_cast<qint64>(simulation.getTick())},
+        {"elapsed_seconds", simulation.getElapsed() / 1000.0},
+        {"crashed", simulation.isCrashed()},
+    };
+
+    QString directory = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(directory);
+    if (perfStats.writeJson(directory + "/perf_summary.json", context)) {
+        LOG_INFO(Game, "Performance summary written for %.0f ticks.", perfStats.getTicks());
+    }
+}
+
+// Writes the traced events of every thread to the app data directory as
+// trace.json, for chrome://tracing or ui.perfetto.dev
+void Game::writeTrace() {
+    QString directory = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(directory);
+    Trace::write(directory + "/trace.json");
+}
+
+// Returns the timings collected for the current run
+const PerfStats& Game::getPerfStats() const {
+    return perfStats;
 }
 
 // Renders the game visuals based on the current game state
 void Game::render(QPainter* painter) {
+    TRACE_SCOPE("render", "render");
     if (showGameOverText) {
-        qDebug() << "Rendering Game Over screen.";
-
-        // Step 1: Fill the entire window with black
-        painter->fillRect(0, 0, WINDOWS_SIZE_X, WINDOWS_SIZE_Y, Qt::black);
-        qDebug() << "Background filled with black.";
-
-        // Step 2: Draw "Game Over" text
-        painter->setPen(Qt::red);
-        painter->setFont(QFont("Arial", 48, QFont::Bold));
-        QString gameOverText = "Game Over";
-        QFontMetrics fm(painter->font());
-        int textWidth = fm.horizontalAdvance(gameOverText);
-        int textHeight = fm.height();
-        painter->drawText((WINDOWS_SIZE_X - textWidth) / 2, (WINDOWS_SIZE_Y - textHeight) / 2, gameOverText);
-        qDebug() << "Game Over text drawn at center.";
-
-        // Step 3: Draw the current time and record time below "Game Over"
-        painter->setPen(Qt::white);
-        painter->setFont(QFont("Arial", 24));
-        QString timeText = QString("Time: %1 s").arg(finalTime, 0, 'f', 2);
-        QString recordText = QString("Record: %1 s").arg(recordTime, 0, 'f', 2);
-
-        // Calculate positions for the time texts
-        int centerX = WINDOWS_SIZE_X / 2;
-
-        // Position texts with vertical spacing
-        int gameOverY = WINDOWS_SIZE_Y / 2;
-        int timeTextY = gameOverY + 50;
-        int recordTextY = gameOverY + 90;
-
-        // Draw time texts centered
-        painter->drawText(centerX - 125, timeTextY, timeText); // Assuming 250 width
-        painter->drawText(centerX - 125, recordTextY, recordText);
-        qDebug() << "Time and Record texts drawn below Game Over.";
+        LOG_TRACE(Render, "Rendering Game Over screen.");
+
+        // Black screen with "Game Over" and the time and record below it
+        hud.drawGameOver(painter, simulation.getFinalTime(), recordTime);
+        LOG_TRACE(Render, "Game Over screen drawn.");
 
         // The Restart Button is shown via QTimer::singleShot in updateGame()
     }
     else {
-        qDebug() << "Rendering normal game screen.";
+        LOG_TRACE(Render, "Rendering normal game screen.");
+
+        // Software blit path: rasterize into the framebuffer and present it with one blit
+        if (composer->getBlitPath() != BlitPath::Painter) {
+            const QSize pixelSize = QSize(WINDOWS_SIZE_X, WINDOWS_SIZE_Y) * devicePixelRatioF();
+            if (framebuffer.size() != pixelSize) {
+                framebuffer = QImage(pixelSize, QImage::Format_ARGB32_Premultiplied);
+                framebuffer.setDevicePixelRatio(devicePixelRatioF());
+            }
+            captureSnapshot(snapshot);
+            composer->compose(framebuffer, snapshot);
+            painter->drawImage(0, 0, framebuffer);
+            LOG_TRACE(Render, "Frame rasterized by the software blitter.");
+
+            if (restartButton->isVisible()) {
+                restartButton->hide();
+            }
+            return;
+        }
 
         // Step 4: Normal game rendering
 
-        // Fill the background with white to ensure black text is visible
-        painter->fillRect(0, 0, WINDOWS_SIZE_X, WINDOWS_SIZE_Y, Qt::white);
-        qDebug() << "Background filled with white.";
-
-        // Draw the animated GIF as background
-        if (background && !background->currentPixmap().isNull()) {
-            painter->drawPixmap(0, 0, WINDOWS_SIZE_X, WINDOWS_SIZE_Y, background->currentPixmap());
-            qDebug() << "Background GIF drawn.";
+        // Draw the cached background frame for the current road position; it is
+        // already scaled and composited over white, so this is a single blit
+        const QPixmap& backgroundFrame = background.frameAt(backgroundTime());
+        if (!backgroundFrame.isNull()) {
+            painter->drawPixmap(0, 0, backgroundFrame);
+            LOG_TRACE(Render, "Background frame drawn.");
         }
         else {
             // If background GIF is not loaded, fill with a solid color
             painter->fillRect(0, 0, WINDOWS_SIZE_X, WINDOWS_SIZE_Y, Qt::darkGray);
-            qDebug() << "Background GIF not loaded. Filled with dark gray.";
+            LOG_TRACE(Render, "Background GIF not loaded. Filled with dark gray.");
         }
 
         // Draw the main car image
-        painter->drawPixmap(mainCar.getX(), mainCar.getY(), mainCar.getPixmap());
-        qDebug() << "Main car drawn at (" << mainCar.getX() << "," << mainCar.getY() << ")";
+        const Car& mainCar = simulation.getMainCar();
+        const SpriteCache& sprites = SpriteCache::instance();
+        painter->drawPixmap(QPointF(mainCar.getX(), mainCar.getY()), sprites.pixmap(mainCar.getSprite()));
+        LOG_TRACE(Render, "Main car drawn at (%.0f, %.1f)", mainCar.getX(), mainCar.getY());
+
+        // Draw the traffic cars that are on screen
+        const Traffic& traffic = simulation.getTraffic();
+        for (int i = 0; i < traffic.size(); ++i) {
+            float carY = traffic.getRenderY(i, interpolation);
+            if (carY > WINDOWS_SIZE_Y || carY + CAR_SIZE_Y < 0) {
+                continue;
+            }
+            painter->drawPixmap(QPointF(traffic.getX(i), carY), sprites.pixmap(traffic.getSprite(i)));
+        }
+        LOG_TRACE(Render, "Traffic cars drawn.");
 
-        // Draw secondary cars
-        painter->drawPixmap(secondaryCar1.getX(), secondaryCar1.getY(), secondaryCar1.getPixmap());
-        painter->drawPixmap(secondaryCar2.getX(), secondaryCar2.getY(), secondaryCar2.getPixmap());
-        painter->drawPixmap(secondaryCar3.getX(), secondaryCar3.getY(), secondaryCar3.getPixmap());
-        qDebug() << "Secondary cars drawn.";
+        // Draw the crash debris and smoke, and the exhaust trails
+        particleRenderer.draw(painter, particles.getBatch());
 
         // Get the elapsed time in seconds
-        double_t elapsedTime = elapsed / 1000.0; // Convert milliseconds to seconds
-
-        // Draw the timer background
-        painter->setBrush(Qt::black); // Set brush to black
-        painter->setPen(Qt::NoPen); // No border
-        painter->drawRect(10, 10, 140, 30); // Draw the rectangle for the background
-        qDebug() << "Timer background drawn.";
+        double_t elapsedTime = simulation.getElapsed() / 1000.0; // Convert milliseconds to seconds
 
-        // Draw the timer text in white
-        painter->setPen(Qt::white); // Set text color to white
-        painter->setFont(QFont("Arial", 16)); // Set font and size
-        painter->drawText(15, 32, QString("Time: %1").arg(elapsedTime, 0, 'f', 2)); // Draw the time with two decimal places
-        qDebug() << "Timer text drawn:" << QString("Time: %1").arg(elapsedTime, 0, 'f', 2);
+        // Draw the timer box in the upper left corner
+        hud.drawTimer(painter, elapsedTime);
+        LOG_TRACE(Render, "Timer text drawn: Time: %.2f", elapsedTime);
 
         // Hide the Restart Button if it's visible
         if (restartButton->isVisible()) {
             restartButton->hide();
-            qDebug() << "Restart button hidden during normal game rendering.";
+            LOG_TRACE(Render, "Restart button hidden during normal game rendering.");
         }
     }
 }
 
+// Returns the simulation the game renders and feeds
+Simulation& Game::getSimulation() {
+    return simulation;
+}
+
 // Handles the restart logic when the Restart Button is clicked
 void Game::restartGame() {
-    qDebug() << "Restart button clicked. Restarting the game.";
+    LOG_INFO(Game, "Restart button clicked. Restarting the game.");
 
     // Reset game state variables
     isGameOver = false;
     showGameOverText = false;
-    finalTime = 0.0;
-    elapsed = 0;
-    level = 2;
-    qDebug() << "Game state variables reset.";
-
-    // Reset the main car position
-    mainCar.setX((WINDOWS_SIZE_X - CAR_SIZE_X) / 2); // Centered horizontally
-    mainCar.setY(WINDOWS_SIZE_Y - CAR_SIZE_Y - 20); // Positioned near the bottom
-    mainCar.loadImage(":/img/car_image.png", CAR_SIZE_X, CAR_SIZE_Y); // Reload main car image
-    qDebug() << "Main car position reset and image reloaded.";
-
-    // Reset secondary cars positions
-    secondaryCar1.setX(WINDOWS_SIZE_X - CAR_SIZE_X - 15); // Right lane
-    secondaryCar1.setY(-CAR_SIZE_Y - (rand() % 800) + 2000); // Random Y within bounds
-    qDebug() << "SecondaryCar1 position reset to (" << secondaryCar1.getX() << "," << secondaryCar1.getY() << ")";
-
-    secondaryCar2.setX(15); // Left lane
-    secondaryCar2.setY(-CAR_SIZE_Y - (rand() % 800) + 2000); // Random Y within bounds
-    qDebug() << "SecondaryCar2 position reset to (" << secondaryCar2.getX() << "," << secondaryCar2.getY() << ")";
-
-    secondaryCar3.setX((WINDOWS_SIZE_X - CAR_SIZE_X) / 2 - 10); // Center lane
-    secondaryCar3.setY(-CAR_SIZE_Y - (rand() % 800) + 2000); // Random Y within bounds
-    qDebug() << "SecondaryCar3 position reset to (" << secondaryCar3.getX() << "," << secondaryCar3.getY() << ")";
+    inputQueue.clear();
+    latencyProbes.clear();
+    particles.clear();
+    LOG_INFO(Game, "Game state variables reset.");
+
+    // Reset the cars to their starting positions and sprites with a new seed
+    beginRun();
+    LOG_INFO(Game, "Simulation reset.");
 
     // Reload background animation if needed
-    if (background && !background->isValid()) {
-        delete background;
-        background = new QMovie(":/img/background.gif");
-        if (background->isValid()) {
-            background->start();
-            qDebug() << "Background GIF reloaded and animation started.";
-        } else {
-            qDebug() << "Failed to reload background GIF!";
-        }
+    if (!background.isValid()) {
+        loadBackground();
     }
 
-    // Restart the elapsed timer
-    ecTimer.restart();
-    qDebug() << "Elapsed timer restarted.";
-
-    // Reconnect the timer signal to the updateGame slot
-    // First, ensure no duplicate connections by disconnecting existing ones
-    disconnect(timer, &QTimer::timeout, this, &Game::updateGame);
-    connect(timer, &QTimer::timeout, this, &Game::updateGame);
-    timer->start(16); // Approximately 60 FPS
-    qDebug() << "Timer reconnected to updateGame slot and started.";
+    // Restart the frame loop
+    startLoop();
 
     // Hide the Restart Button
     restartButton->hide();
-    qDebug() << "Restart button hidden after restarting the game.";
+    LOG_INFO(Game, "Restart button hidden after restarting the game.");
 
     // Set focus back to the game widget to receive key events
     this->setFocus();
-    qDebug() << "Focus set back to game widget after restart.";
+    LOG_INFO(Game, "Focus set back to game widget after restart.");
 
     // Trigger a repaint to update the UI
-    update();
-    qDebug() << "UI repaint triggered after restart.";
+    requestFrame();
+    LOG_INFO(Game, "UI repaint triggered after restart.");
 }
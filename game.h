@@ -4,60 +4,122 @@
 #include <QPainter>
 #include <QKeyEvent>
 #include <QPixmap>
-#include <QMovie>
 #include <QWidget>
-#include <QSettings>
 #include <QElapsedTimer>
 #include <QPushButton>
+#include <QVector>
 #include "shared.h"
-#include "car.h"
+#include "simulation.h"
+#include "backgroundcache.h"
+#include "runlog.h"
+#include "framecomposer.h"
+#include "hud.h"
+#include "perfstats.h"
+#include "autopilot.h"
+#include "inputqueue.h"
+#include "scorestore.h"
+#include "framepacer.h"
+#include "particles.h"
+#include "particlerenderer.h"
 
-#define MOVING_STEP (WINDOWS_SIZE_X / 3)
+#define BACKGROUND_BASE_SPEED (3 * SPEED_PER_LEVEL) // Road speed at which the background plays at its native frame rate
 
 class Game : public QWidget
 {
     Q_OBJECT
 
 public:
-    explicit Game(QWidget* parent = nullptr, QTimer* timer = nullptr);
+    explicit Game(QWidget* parent = nullptr);
     ~Game();
     void paintEvent(QPaintEvent* event);
     void keyPressEvent(QKeyEvent* event);
     void keyReleaseEvent(QKeyEvent* event);
     void updateGame();
+    void updateParticles(float seconds);
     void render(QPainter* painter);
     void restartGame();
-    void initializeCarPositions();
     void loadBackground();
     void initializeRestartButton();
+    Simulation& getSimulation();
+    void setStaticBackground(bool enabled);
+    void setSmoothLaneChange(bool enabled);
+    void setStartupClock(const QElapsedTimer& clock);
+    void setThreadedRendering(bool enabled);
+    void setBlitPath(BlitPath path);
+    void setFramePacing(FramePacing mode);
+    void captureSnapshot(FrameSnapshot& frame) const;
+    const PerfStats& getPerfStats() const;
+
+protected:
+    void showEvent(QShowEvent* event) override;
+
 private:
-    Car mainCar;
-    Car secondaryCar1;
-    Car secondaryCar2;
-    Car secondaryCar3;
-    QMovie* background;
-    QTimer* timer;
+    Simulation simulation;
+    InputQueue inputQueue; // Steering presses waiting for their tick, stamped with ecTimer nanoseconds
+
+    // A press applied on a tick, waiting for a frame that shows that tick
+    struct LatencyProbe {
+        qint64 timestamp;
+        quint32 tick;
+    };
+    QVector<LatencyProbe> latencyProbes;
+    RunLog runLog; // Seed and inputs of the current run, saved when it ends
+    BackgroundCache background;
+    FramePacer pacer; // Single clock driving both simulation and repaint
     QElapsedTimer ecTimer;
-    int level;
+    QElapsedTimer startupClock; // Started in main(); invalid once the first frame is reported
+    qint64 lastFrameTime; // ecTimer reading at the previous frame, in nanoseconds
+    qint64 accumulator; // Real time not yet consumed by fixed simulation steps, in nanoseconds
+    float interpolation; // Fraction of a step between the last two simulation states
+
+    // Dirty-region repaint
+    bool staticBackground; // Freeze the road animation so only moving sprites are repainted
+    int paintedBackgroundFrame; // Background frame index of the last scheduled repaint
+    QVector<QRect> paintedRects; // Sprite and HUD rects of the last scheduled repaint
+    QVector<QRect> frameRects; // Scratch list for the rects of the next frame
+
+    // Off-thread composition
+    FrameComposer* composer; // Draws frames on a worker thread when threaded rendering is on
+    FrameSnapshot snapshot; // Reused storage for the state handed to the composer
+    QImage framebuffer; // Target of the single-threaded software blit path
+
+    // Lookahead autopilot, toggled with A; arrow keys take control back
+    Autopilot autopilot;
+    bool autopilotEnabled;
+
+    Hud hud; // Fonts and text layouts of the paint path on the GUI thread
+
+    // Crash debris and smoke, and exhaust behind traffic; visual only, on frame time
+    ParticleSystem particles;
+    ParticleRenderer particleRenderer; // Rect lists of the paint path on the GUI thread
+
+    // Performance overlay and summary
+    PerfStats perfStats; // Frame, tick and render timings of the current run
+    bool showPerfOverlay; // Toggled with F3
 
     // Game state variables
     bool isGameOver;
     bool showGameOverText;
     double recordTime;
-    double finalTime;
-
-    // Settings for persistent storage
-    QSettings settings;
 
-    // Timing
-    qint64 elapsed; // Elapsed time in milliseconds
+    // Every finished run, written in the background and ranked on leaderboards
+    ScoreStore scores;
 
     QPushButton* restartButton;
 
     // Methods
-    bool inRange(int playerX);
-    bool checkCollision();
-    bool isValidPosition(int padding);
+    void startLoop();
+    void beginRun();
+    void onCrash();
+    void saveRunLog();
+    void writePerfSummary();
+    void writeTrace();
+    qint64 backgroundTime() const;
+    void collectDirtyRects(QVector<QRect>& rects) const;
+    void scheduleRepaint();
+    void requestFrame();
+    void refreshComposerImages();
+    void collectLoadedAssets();
 };
 
 #endif // GAME_H
@@ -0,0 +1,116 @@
+#include "gamelog.h"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+
+// ===========================
+// GameLog Implementation
+// ===========================
+
+namespace GameLog {
+
+namespace {
+
+static_assert((GAME_LOG_CAPACITY & (GAME_LOG_CAPACITY - 1)) == 0, "GAME_LOG_CAPACITY must be a power of two");
+
+struct Entry {
+    std::atomic<std::uint64_t> sequence{0}; // Slot index + 1 once the entry is complete, 0 while being written
+    std::int64_t timestampNs;
+    const char* format;
+    double args[GAME_LOG_MAX_ARGS];
+    Category category;
+    Level level;
+};
+
+Entry buffer[GAME_LOG_CAPACITY];
+std::atomic<std::uint64_t> head{0};
+std::atomic<int> minimumLevel{static_cast<int>(Level::Trace)};
+const auto startTime = std::chrono::steady_clock::now();
+
+void crashSignalHandler(int signal) {
+    std::fprintf(stderr, "Fatal signal %d, dumping game log:\n", signal);
+    dump(stderr);
+    std::signal(signal, SIG_DFL);
+    std::raise(signal);
+}
+
+} // namespace
+
+// Returns a printable name for a log category
+const char* categoryName(Category category) {
+    switch (category) {
+    case Category::Car: return "car";
+    case Category::Simulation: return "simulation";
+    case Category::Game: return "game";
+    case Category::Render: return "render";
+    case Category::Input: return "input";
+    default: return "?";
+    }
+}
+
+// Returns a printable name for a log level
+const char* levelName(Level level) {
+    switch (level) {
+    case Level::Trace: return "trace";
+    case Level::Debug: return "debug";
+    case Level::Info: return "info";
+    case Level::Warning: return "warning";
+    default: return "?";
+    }
+}
+
+// Sets the lowest level that is still recorded
+void setMinimumLevel(Level level) {
+    minimumLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+// Returns true if entries of the given level are currently recorded
+bool isEnabled(Level level) {
+    return static_cast<int>(level) >= minimumLevel.load(std::memory_order_relaxed);
+}
+
+// Claims the next ring slot and fills it; never blocks and never allocates
+void record(Category category, Level level, const char* format, const double* args, int argCount) {
+    std::uint64_t slot = head.fetch_add(1, std::memory_order_relaxed);
+    Entry& entry = buffer[slot & (GAME_LOG_CAPACITY - 1)];
+
+    entry.sequence.store(0, std::memory_order_relaxed);
+    entry.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - startTime).count();
+    entry.format = format;
+    for (int i = 0; i < GAME_LOG_MAX_ARGS; ++i) {
+        entry.args[i] = i < argCount ? args[i] : 0.0;
+    }
+    entry.category = category;
+    entry.level = level;
+    entry.sequence.store(slot + 1, std::memory_order_release);
+}
+
+// Formats the buffered entries, skipping any slot that is mid-write or was overwritten
+void dump(std::FILE* out) {
+    std::uint64_t end = head.load(std::memory_order_acquire);
+    std::uint64_t begin = end > GAME_LOG_CAPACITY ? end - GAME_LOG_CAPACITY : 0;
+
+    for (std::uint64_t slot = begin; slot < end; ++slot) {
+        const Entry& entry = buffer[slot & (GAME_LOG_CAPACITY - 1)];
+        if (entry.sequence.load(std::memory_order_acquire) != slot + 1) {
+            continue;
+        }
+        char message[256];
+        std::snprintf(message, sizeof(message), entry.format,
+                      entry.args[0], entry.args[1], entry.args[2], entry.args[3]);
+        std::fprintf(out, "[%12.6f] %-10s %-7s %s\n", entry.timestampNs / 1e9,
+                     categoryName(entry.category), levelName(entry.level), message);
+    }
+    std::fflush(out);
+}
+
+// Installs handlers that dump the buffer before the process dies
+void installCrashHandler() {
+    std::signal(SIGSEGV, crashSignalHandler);
+    std::signal(SIGABRT, crashSignalHandler);
+    std::signal(SIGFPE, crashSignalHandler);
+}
+
+} // namespace GameLog
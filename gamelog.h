@@ -0,0 +1,74 @@
+#ifndef GAMELOG_H
+#define GAMELOG_H
+
+#include <cstdio>
+#include <type_traits>
+
+// Lightweight logging for the frame path.
+//
+// In debug builds every GAME_LOG call stores the format string pointer and up
+// to four numeric arguments in a lock-free in-memory ring buffer; nothing is
+// formatted or written until the buffer is dumped (on demand or on a fatal
+// signal). In release builds (QT_NO_DEBUG / NDEBUG) the macros compile to
+// nothing and their arguments are not evaluated.
+//
+// Format strings must be string literals and may only use floating point
+// conversions (%g, %f, %.2f, ...), because every argument is stored as double.
+// A double holds integers exactly only up to 2^53, so 64-bit values such as
+// seeds are logged as their high and low 32-bit halves.
+
+#if defined(QT_NO_DEBUG) || defined(NDEBUG)
+#define GAME_LOG_ENABLED 0
+#else
+#define GAME_LOG_ENABLED 1
+#endif
+
+#define GAME_LOG_CAPACITY 4096 // Entries kept in the ring buffer (power of two)
+#define GAME_LOG_MAX_ARGS 4
+
+namespace GameLog {
+
+enum class Category { Car, Simulation, Game, Render, Input, Count };
+enum class Level { Trace, Debug, Info, Warning };
+
+const char* categoryName(Category category);
+const char* levelName(Level level);
+
+// Entries below this level are dropped before they reach the buffer
+void setMinimumLevel(Level level);
+bool isEnabled(Level level);
+
+void record(Category category, Level level, const char* format,
+            const double* args, int argCount);
+
+// Writes the buffered entries, oldest first, to the given stream
+void dump(std::FILE* out);
+
+// Dumps the buffer to stderr when the process receives SIGSEGV/SIGABRT/SIGFPE
+void installCrashHandler();
+
+template <typename... Args>
+inline void log(Category category, Level level, const char* format, Args... args) {
+    static_assert(sizeof...(Args) <= GAME_LOG_MAX_ARGS, "GAME_LOG takes at most four arguments");
+    static_assert((std::is_arithmetic<Args>::value && ...), "GAME_LOG arguments must be numbers");
+    if (!isEnabled(level)) {
+        return;
+    }
+    const double values[GAME_LOG_MAX_ARGS + 1] = { static_cast<double>(args)..., 0.0 };
+    record(category, level, format, values, static_cast<int>(sizeof...(Args)));
+}
+
+} // namespace GameLog
+
+#if GAME_LOG_ENABLED
+#define GAME_LOG(category, level, ...) \
+    GameLog::log(GameLog::Category::category, GameLog::Level::level, __VA_ARGS__)
+#else
+#define GAME_LOG(category, level, ...) do {} while (0)
+#endif
+
+#define LOG_TRACE(category, ...) GAME_LOG(category, Trace, __VA_ARGS__)
+#define LOG_DEBUG(category, ...) GAME_LOG(category, Debug, __VA_ARGS__)
+#define LOG_INFO(category, ...) GAME_LOG(category, Info, __VA_ARGS__)
+
+#endif // GAMELOG_H
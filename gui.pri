@@ -0,0 +1,28 @@
+# Widget layer shared by the application and the benchmarks: the Game
+# widget, its sprite and background caches, the frame pacer, the
+# particle renderer and the embedded images.
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/backgroundcache.cpp \
+    $$PWD/framecomposer.cpp \
+    $$PWD/framepacer.cpp \
+    $$PWD/game.cpp \
+    $$PWD/hud.cpp \
+    $$PWD/particlerenderer.cpp \
+    $$PWD/spriteblitter.cpp \
+    $$PWD/spritecache.cpp
+
+HEADERS += \
+    $$PWD/backgroundcache.h \
+    $$PWD/framecomposer.h \
+    $$PWD/framepacer.h \
+    $$PWD/game.h \
+    $$PWD/hud.h \
+    $$PWD/particlerenderer.h \
+    $$PWD/spriteblitter.h \
+    $$PWD/spritecache.h
+
+RESOURCES += \
+    $$PWD/resources.qrc
@@ -0,0 +1,144 @@
+#include "hud.h"
+#include <QFontMetrics>
+#include "shared.h"
+
+// ===========================
+// Hud Class Implementation
+// ===========================
+
+// Prepares a QStaticText for plain text drawn often with the same font
+static void prepareText(QStaticText& text, const QString& string, const QFont& font) {
+    text.setTextFormat(Qt::PlainText);
+    text.setPerformanceHint(QStaticText::AggressiveCaching);
+    text.setText(string);
+    text.prepare(QTransform(), font);
+}
+
+// Constructor builds the fonts, the timer glyphs and the game over title once
+Hud::Hud()
+    : timerFont("Arial", 16),
+    titleFont("Arial", 48, QFont::Bold),
+    resultFont("Arial", 24),
+    perfFont("Courier", 9),
+    shownFinalTime(-1),
+    shownRecordTime(-1)
+{
+    QFontMetricsF timerMetrics(timerFont);
+    prepareText(timerLabel, "Time: ", timerFont);
+    timerLabelAdvance = timerMetrics.horizontalAdvance("Time: ");
+    timerAscent = timerMetrics.ascent();
+    for (int i = 0; i < HUD_TIMER_GLYPHS; ++i) {
+        QChar glyph = i < 10 ? QChar('0' + i) : QChar('.');
+        prepareText(timerGlyphs[i], QString(glyph), timerFont);
+        timerGlyphAdvance[i] = timerMetrics.horizontalAdvance(glyph);
+    }
+
+    // Centered like drawText at the baseline ((width - text width) / 2, (height - line height) / 2)
+    QFontMetrics titleMetrics(titleFont);
+    prepareText(titleText, "Game Over", titleFont);
+    int titleBaseline = (WINDOWS_SIZE_Y - titleMetrics.height()) / 2;
+    titlePosition = QPointF((WINDOWS_SIZE_X - titleMetrics.horizontalAdvance("Game Over")) / 2,
+                            titleBaseline - titleMetrics.ascent());
+    resultAscent = QFontMetricsF(resultFont).ascent();
+}
+
+// Draws the elapsed time in white on a black box in the upper left corner
+void Hud::drawTimer(QPainter* painter, double elapsedSeconds) {
+    // Draw the timer background
+    painter->setBrush(Qt::black); // Set brush to black
+    painter->setPen(Qt::NoPen); // No border
+    painter->drawRect(HUD_TIMER_RECT); // Draw the rectangle for the background
+
+    // Two decimal places, written right to left into a fixed buffer of glyph indices
+    qint64 hundredths = qMax<qint64>(0, qRound64(elapsedSeconds * 100.0));
+    int glyphs[24];
+    int count = 0;
+    glyphs[count++] = hundredths % 10;
+    glyphs[count++] = hundredths / 10 % 10;
+    glyphs[count++] = 10;
+    qint64 seconds = hundredths / 100;
+    do {
+        glyphs[count++] = seconds % 10;
+        seconds /= 10;
+    } while (seconds > 0);
+
+    // Draw the timer text in white, with the baseline at y = 32
+    painter->setPen(Qt::white); // Set text color to white
+    painter->setFont(timerFont);
+    const qreal top = 32 - timerAscent;
+    qreal x = 15;
+    painter->drawStaticText(QPointF(x, top), timerLabel);
+    x += timerLabelAdvance;
+    while (count > 0) {
+        int glyph = glyphs[--count];
+        painter->drawStaticText(QPointF(x, top), timerGlyphs[glyph]);
+        x += timerGlyphAdvance[glyph];
+    }
+}
+
+// Draws the black game over screen with the run time and the record below it
+void Hud::drawGameOver(QPainter* painter, double finalTime, double recordTime) {
+    // Step 1: Fill the entire window with black
+    painter->fillRect(0, 0, WINDOWS_SIZE_X, WINDOWS_SIZE_Y, Qt::black);
+
+    // Step 2: Draw "Game Over" text
+    painter->setPen(Qt::red);
+    painter->setFont(titleFont);
+    painter->drawStaticText(titlePosition, titleText);
+
+    // Step 3: Draw the current time and record time below "Game Over"; the
+    // texts only change when a run ends
+    qint64 finalHundredths = qRound64(finalTime * 100.0);
+    if (finalHundredths != shownFinalTime) {
+        prepareText(timeText, QString("Time: %1 s").arg(finalTime, 0, 'f', 2), resultFont);
+        shownFinalTime = finalHundredths;
+    }
+    qint64 recordHundredths = qRound64(recordTime * 100.0);
+    if (recordHundredths != shownRecordTime) {
+        prepareText(recordText, QString("Record: %1 s").arg(recordTime, 0, 'f', 2), resultFont);
+        shownRecordTime = recordHundredths;
+    }
+    painter->setPen(Qt::white);
+    painter->setFont(resultFont);
+
+    // Calculate positions for the time texts
+    int centerX = WINDOWS_SIZE_X / 2;
+
+    // Position texts with vertical spacing
+    int gameOverY = WINDOWS_SIZE_Y / 2;
+    int timeTextY = gameOverY + 50;
+    int recordTextY = gameOverY + 90;
+
+    // Draw time texts centered, with their baselines at the positions above
+    painter->drawStaticText(QPointF(centerX - 125, timeTextY - resultAscent), timeText); // Assuming 250 width
+    painter->drawStaticText(QPointF(centerX - 125, recordTextY - resultAscent), recordText);
+}
+
+// Draws frame-time percentiles, per-phase timings and tick counters on a translucent box
+void Hud::drawPerfOverlay(QPainter* painter, const PerfStats& stats) {
+    painter->setBrush(QColor(0, 0, 0, 180));
+    painter->setPen(Qt::NoPen);
+    painter->drawRect(HUD_PERF_RECT);
+
+    painter->setPen(Qt::green);
+    painter->setFont(perfFont);
+    const int left = HUD_PERF_RECT.left() + 6;
+    int baseline = HUD_PERF_RECT.top() + 16;
+
+    // One row per phase: p50, p95 and p99 in microseconds
+    for (int i = 0; i < static_cast<int>(PerfPhase::Count); ++i) {
+        const LatencyHistogram& histogram = stats.getHistogram(static_cast<PerfPhase>(i));
+        painter->drawText(left, baseline, QString("%1 p50 %2 p95 %3 p99 %4 us")
+                                              .arg(QLatin1String(PerfStats::phaseName(static_cast<PerfPhase>(i))), -12)
+                                              .arg(histogram.percentile(0.50) / 1000.0, 7, 'f', 1)
+                                              .arg(histogram.percentile(0.95) / 1000.0, 7, 'f', 1)
+                                              .arg(histogram.percentile(0.99) / 1000.0, 7, 'f', 1));
+        baseline += 18;
+    }
+
+    painter->drawText(left, baseline, QString("ticks/s %1  late %2  dropped %3  missed %4")
+                                          .arg(stats.getTickRate(), 0, 'f', 1)
+                                          .arg(stats.getLateTicks())
+                                          .arg(stats.getDroppedTicks())
+                                          .arg(stats.getMissedFrames()));
+}
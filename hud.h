@@ -0,0 +1,51 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <QFont>
+#include <QPainter>
+#include <QStaticText>
+#include "perfstats.h"
+
+#define HUD_TIMER_RECT QRect(10, 10, 140, 30) // Black box behind the elapsed time
+#define HUD_PERF_RECT QRect(10, 50, 380, 182) // Performance overlay below the timer
+#define HUD_TIMER_GLYPHS 11 // Digits 0-9 and the decimal point
+
+// Text overlays shared by every render path. Only QPainter is used, so
+// they can draw into a widget or into a QImage on a worker thread; each
+// painting thread owns its own Hud.
+// Fonts, metrics and text layouts are built once. The timer is drawn from
+// one cached QStaticText per digit, so a running frame allocates nothing.
+// The game over texts are laid out again only when the times change, and
+// the performance overlay is a diagnostic that formats its text each frame.
+class Hud
+{
+public:
+    Hud();
+    void drawTimer(QPainter* painter, double elapsedSeconds);
+    void drawGameOver(QPainter* painter, double finalTime, double recordTime);
+    void drawPerfOverlay(QPainter* painter, const PerfStats& stats);
+
+private:
+    QFont timerFont;
+    QFont titleFont;
+    QFont resultFont;
+    QFont perfFont;
+
+    // Running timer: "Time: " followed by the number, one glyph at a time
+    QStaticText timerLabel;
+    QStaticText timerGlyphs[HUD_TIMER_GLYPHS];
+    qreal timerGlyphAdvance[HUD_TIMER_GLYPHS];
+    qreal timerLabelAdvance;
+    qreal timerAscent;
+
+    // Game over screen
+    QStaticText titleText;
+    QStaticText timeText;
+    QStaticText recordText;
+    QPointF titlePosition; // Top left of the centered title
+    qreal resultAscent;
+    qint64 shownFinalTime; // Hundredths in timeText, or -1 before the first game over
+    qint64 shownRecordTime; // Hundredths in recordText
+};
+
+#endif // HUD_H
@@ -0,0 +1,42 @@
+#include "inputqueue.h"
+
+// ===========================
+// InputQueue Class Implementation
+// ===========================
+
+// Constructor creates an empty queue
+InputQueue::InputQueue() : head(0), count(0) {}
+
+// Drops every queued press
+void InputQueue::clear() {
+    head = 0;
+    count = 0;
+}
+
+// Appends a press; a full queue keeps the older presses
+bool InputQueue::push(qint64 timestamp, int steer) {
+    if (count == INPUT_QUEUE_CAPACITY) {
+        return false;
+    }
+    InputEvent& event = events[(head + count) % INPUT_QUEUE_CAPACITY];
+    event.timestamp = timestamp;
+    event.steer = static_cast<qint8>(steer < 0 ? -1 : 1);
+    ++count;
+    return true;
+}
+
+// Removes and returns the oldest press if it arrived at or before time
+bool InputQueue::takeUntil(qint64 time, InputEvent& event) {
+    if (count == 0 || events[head].timestamp > time) {
+        return false;
+    }
+    event = events[head];
+    head = (head + 1) % INPUT_QUEUE_CAPACITY;
+    --count;
+    return true;
+}
+
+// Returns the number of queued presses
+int InputQueue::size() const {
+    return count;
+}
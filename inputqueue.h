@@ -0,0 +1,33 @@
+#ifndef INPUTQUEUE_H
+#define INPUTQUEUE_H
+
+#include <QtGlobal>
+
+#define INPUT_QUEUE_CAPACITY 64 // Far more presses than fit between two frames
+
+// A steering key press with the time it arrived
+struct InputEvent {
+    qint64 timestamp; // Nanoseconds on the game clock
+    qint8 steer; // -1 left, +1 right
+};
+
+// Fixed-capacity FIFO of steering presses. Key events only enqueue; each
+// simulation tick takes at most one press that arrived before the tick was
+// due, so presses are applied in order, on tick boundaries, and none are
+// merged or lost when several arrive within one frame.
+class InputQueue
+{
+public:
+    InputQueue();
+    void clear();
+    bool push(qint64 timestamp, int steer); // False if the queue is full
+    bool takeUntil(qint64 time, InputEvent& event); // Oldest press at or before time
+    int size() const;
+
+private:
+    InputEvent events[INPUT_QUEUE_CAPACITY];
+    int head; // Index of the oldest press
+    int count;
+};
+
+#endif // INPUTQUEUE_H
@@ -1,11 +1,156 @@
 #include "mainwindow.h"
+#include "framepacer.h"
+#include "gamelog.h"
+#include "runlog.h"
+#include "scorestore.h"
+#include "spriteblitter.h"
+#include "trace.h"
 
 #include <QApplication>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QStandardPaths>
+#include <cstdio>
+#include <cstring>
+
+// Replays a run log headless, as fast as the CPU allows, and checks that it
+// ends exactly like the recorded run. A replay that drifts from the recording
+// may never crash, so it is cut off RUN_LOG_REPLAY_SLACK_TICKS after the
+// recorded crash. Returns the process exit code.
+static int replayRunLog(const char* path)
+{
+    RunLog log;
+    if (!log.load(QString::fromLocal8Bit(path))) {
+        return 2;
+    }
+
+    const RunOutcome& recorded = log.getOutcome();
+    const quint32 maxTicks = recorded.crashTick + RUN_LOG_REPLAY_SLACK_TICKS;
+    QElapsedTimer timer;
+    timer.start();
+    RunOutcome result = log.replay(maxTicks);
+    qint64 nsecs = qMax<qint64>(1, timer.nsecsElapsed());
+
+    bool matches = result.crashed == recorded.crashed && result.crashTick == recorded.crashTick &&
+                   result.playerLane == recorded.playerLane && result.elapsed == recorded.elapsed;
+
+    std::printf("seed %llu, %d lanes, %d cars, %d ms step, %d tick lane change, %lld events\n",
+                static_cast<unsigned long long>(log.getSeed()), log.getLaneCount(), log.getTrafficCount(),
+                log.getStepMs(), log.getLaneChangeTicks(), static_cast<long long>(log.getEvents().size()));
+    std::printf("recorded: crash tick %u, lane %d, %.2f s\n",
+                recorded.crashTick, recorded.playerLane, recorded.elapsed / 1000.0);
+    if (result.crashed) {
+        std::printf("replayed: crash tick %u, lane %d, %.2f s\n",
+                    result.crashTick, result.playerLane, result.elapsed / 1000.0);
+    } else {
+        std::printf("replayed: no crash within %u ticks, lane %d, %.2f s\n",
+                    maxTicks, result.playerLane, result.elapsed / 1000.0);
+    }
+    std::printf("%u ticks in %.3f ms (%.0f ticks/s): %s\n", result.crashTick, nsecs / 1e6,
+                result.crashTick * 1e9 / nsecs, matches ? "MATCH" : "MISMATCH");
+    return matches ? 0 : 1;
+}
+
+// Prints the all-time leaderboard and the best run of each of the last seven days
+static int printScores()
+{
+    ScoreStore scores;
+    if (!scores.open(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation))) {
+        return 2;
+    }
+    const ScoreBoard& board = scores.getBoard();
+
+    std::printf("%llu runs\n", static_cast<unsigned long long>(scores.getRunCount()));
+    for (quint32 i = 0; i < board.topCount; ++i) {
+        const ScoreRecord& run = board.top[i];
+        std::printf("%2u. %8.2f s  level %d  seed %llu  %s\n", i + 1, run.finalTime, run.level,
+                    static_cast<unsigned long long>(run.seed),
+                    qPrintable(QDateTime::fromMSecsSinceEpoch(run.endedAt).toString(Qt::ISODate)));
+    }
+
+    QDate today = QDate::currentDate();
+    for (int back = 0; back < 7; ++back) {
+        QDate day = today.addDays(-back);
+        const ScoreRecord* best = board.bestOfDay(static_cast<qint32>(day.toJulianDay()));
+        if (best) {
+            std::printf("%s best %.2f s\n", qPrintable(day.toString(Qt::ISODate)), best->finalTime);
+        }
+    }
+    return 0;
+}
 
 int main(int argc, char *argv[])
 {
+    // Debug builds report the time from here to the first painted frame
+    QElapsedTimer startup;
+    startup.start();
+
+    // Dump the in-memory game log if the process crashes
+    GameLog::installCrashHandler();
+
+    // Replay and the score listing run without a display, so they are decided before creating QApplication
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            QCoreApplication app(argc, argv);
+            return replayRunLog(argv[i + 1]);
+        }
+        if (std::strcmp(argv[i], "--scores") == 0) {
+            QCoreApplication app(argc, argv);
+            return printScores();
+        }
+    }
+
     QApplication a(argc, argv);
+    Trace::setThreadName("gui");
+
+    // Record a timeline from the start; it is written on exit, or at any time with F9
+    if (a.arguments().contains("--trace")) {
+        Trace::setEnabled(true);
+    }
+
     MainWindow w;
+    w.getGame()->setStartupClock(startup);
+
+    // A frozen road lets the game repaint only the moving sprites (low-end kiosks)
+    if (a.arguments().contains("--static-background")) {
+        w.getGame()->setStaticBackground(true);
+    }
+
+    // Glide between lanes over a few ticks instead of jumping
+    if (a.arguments().contains("--smooth-lanes")) {
+        w.getGame()->setSmoothLaneChange(true);
+    }
+
+    // Rasterize with the software blitter: --blitter painter|scalar|sse2|avx2|auto
+    int blitterIndex = a.arguments().indexOf("--blitter");
+    if (blitterIndex > 0 && blitterIndex + 1 < a.arguments().size()) {
+        bool ok = false;
+        BlitPath path = SpriteBlitter::fromName(a.arguments().at(blitterIndex + 1), &ok);
+        if (!ok) {
+            qWarning() << "Unknown blitter" << a.arguments().at(blitterIndex + 1) << "- using"
+                       << SpriteBlitter::name(path);
+        }
+        w.getGame()->setBlitPath(path);
+    }
+
+    // Drive frames with --pacing coarse|precise|display (precise by default)
+    int pacingIndex = a.arguments().indexOf("--pacing");
+    if (pacingIndex > 0 && pacingIndex + 1 < a.arguments().size()) {
+        bool ok = false;
+        FramePacing mode = FramePacer::fromName(a.arguments().at(pacingIndex + 1), &ok);
+        if (!ok) {
+            qWarning() << "Unknown frame pacing" << a.arguments().at(pacingIndex + 1) << "- using"
+                       << FramePacer::modeName(mode);
+        }
+        w.getGame()->setFramePacing(mode);
+    }
+
+    // Compose frames on a worker thread so slow frames do not delay input handling
+    if (a.arguments().contains("--threaded-render")) {
+        w.getGame()->setThreadedRendering(true);
+    }
     w.show();
     return a.exec();
 }
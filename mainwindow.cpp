@@ -1,7 +1,5 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
-#include <QKeyEvent>
-#include <QTimer>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -11,12 +9,13 @@ MainWindow::MainWindow(QWidget *parent)
 
     setFixedSize(WINDOWS_SIZE_X, WINDOWS_SIZE_Y);
 
-    // Set up the timer
-    QTimer* timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, &MainWindow::updateGame); // Connect to the update method
-    timer->start(20); // Approximately 60 FPS
+    // The game owns the only frame timer and steps its simulation at a fixed rate.
+    // It covers the whole window and is the only widget that renders the game.
+    game = new Game(this);
+    game->move(0, 0);
 
-    game = new Game(this, timer);
+    // Keys reach the game through focus only, so a press is never dispatched twice
+    setFocusProxy(game);
 }
 
 MainWindow::~MainWindow()
@@ -24,20 +23,6 @@ MainWindow::~MainWindow()
     delete ui;
 }
 
-void MainWindow::keyPressEvent(QKeyEvent *event) {
-    game->keyPressEvent(event);
-}
-
-void MainWindow::keyReleaseEvent(QKeyEvent *event) {
-    game->keyReleaseEvent(event);
-}
-
-void MainWindow::paintEvent(QPaintEvent *event) {
-    QPainter painter(this);
-    game->render(&painter); // Render the game
-}
-
-void MainWindow::updateGame() {
-    game->updateGame(); // Update game state
-    update(); // Trigger a repaint
+Game* MainWindow::getGame() const {
+    return game;
 }
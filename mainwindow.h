@@ -14,14 +14,7 @@ class MainWindow : public QMainWindow
 public:
     explicit MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
-
-protected:
-    void keyPressEvent(QKeyEvent *event) override;
-    void keyReleaseEvent(QKeyEvent *event) override;
-    void paintEvent(QPaintEvent *event) override;
-
-private slots: // Add this section if it doesn't exist
-    void updateGame(); // Declare the updateGame method
+    Game* getGame() const;
 
 private:
     Ui::MainWindow *ui;
@@ -0,0 +1,76 @@
+#include "particlerenderer.h"
+#include "spriteblitter.h"
+
+// ===========================
+// ParticleRenderer Class Implementation
+// ===========================
+
+// Constructor builds the bucket colors and the premultiplied color table
+ParticleRenderer::ParticleRenderer() {
+    for (int shade = 0; shade < PARTICLE_SHADES; ++shade) {
+        const QRgb color = ParticleBatch::shadeColor(shade);
+        for (int level = 0; level < PARTICLE_ALPHA_LEVELS; ++level) {
+            // Each step is drawn at the middle of the opacities it covers
+            const int alpha = (2 * level + 1) * 256 / (2 * PARTICLE_ALPHA_LEVELS);
+            bucketColors[shade * PARTICLE_ALPHA_LEVELS + level] =
+                QColor(qRed(color), qGreen(color), qBlue(color), qMin(alpha, 255));
+        }
+        for (int alpha = 0; alpha < 256; ++alpha) {
+            premultiplied[shade][alpha] = qPremultiply(qRgba(qRed(color), qGreen(color), qBlue(color), alpha));
+        }
+    }
+}
+
+// Returns the bucket of a particle: its palette entry and opacity step
+static int bucketOf(const ParticleBatch& batch, int index) {
+    return batch.shade[index] * PARTICLE_ALPHA_LEVELS + batch.alpha[index] * PARTICLE_ALPHA_LEVELS / 256;
+}
+
+// Draws the particles with one drawRects() call per color and opacity step
+void ParticleRenderer::draw(QPainter* painter, const ParticleBatch& batch) {
+    if (batch.count == 0) {
+        return;
+    }
+    if (rects.size() < static_cast<qsizetype>(batch.x.size())) {
+        rects.resize(static_cast<qsizetype>(batch.x.size()));
+    }
+
+    // Count the particles of each bucket, then give every bucket its run of rects
+    int counts[PARTICLE_BUCKETS] = {};
+    int bucketStart[PARTICLE_BUCKETS + 1];
+    for (int i = 0; i < batch.count; ++i) {
+        ++counts[bucketOf(batch, i)];
+    }
+    bucketStart[0] = 0;
+    for (int i = 0; i < PARTICLE_BUCKETS; ++i) {
+        bucketStart[i + 1] = bucketStart[i] + counts[i];
+        counts[i] = bucketStart[i];
+    }
+    QRectF* out = rects.data();
+    for (int i = 0; i < batch.count; ++i) {
+        const float half = batch.size[i] / 2;
+        out[counts[bucketOf(batch, i)]++] = QRectF(batch.x[i] - half, batch.y[i] - half, batch.size[i], batch.size[i]);
+    }
+
+    painter->save();
+    painter->setPen(Qt::NoPen);
+    for (int i = 0; i < PARTICLE_BUCKETS; ++i) {
+        if (bucketStart[i + 1] == bucketStart[i]) {
+            continue;
+        }
+        painter->setBrush(bucketColors[i]);
+        painter->drawRects(out + bucketStart[i], bucketStart[i + 1] - bucketStart[i]);
+    }
+    painter->restore();
+}
+
+// Blends every particle into a premultiplied ARGB32 image at device pixels
+void ParticleRenderer::blend(QImage& target, const ParticleBatch& batch, qreal devicePixelRatio) const {
+    const float scale = static_cast<float>(devicePixelRatio);
+    for (int i = 0; i < batch.count; ++i) {
+        const int edge = qMax(1, qRound(batch.size[i] * scale));
+        const int left = qRound(batch.x[i] * scale - edge * 0.5f);
+        const int top = qRound(batch.y[i] * scale - edge * 0.5f);
+        SpriteBlitter::blendRect(target, QRect(left, top, edge, edge), premultiplied[batch.shade[i]][batch.alpha[i]]);
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef PARTICLERENDERER_H
+#define PARTICLERENDERER_H
+
+#include <QImage>
+#include <QPainter>
+#include <QRectF>
+#include <QVector>
+#include "particles.h"
+
+#define PARTICLE_ALPHA_LEVELS 8 // Opacity steps the painter path batches particles into
+#define PARTICLE_BUCKETS (PARTICLE_SHADES * PARTICLE_ALPHA_LEVELS)
+
+// Draws a ParticleBatch into a frame, with QPainter or straight into the
+// pixels for the software blit paths. The painter path counting-sorts the
+// particles by palette entry and opacity step into one rect array and fills
+// each run with a single drawRects() call, instead of a state change and a
+// fill per particle. The software path blends every particle as a small
+// rect with a premultiplied color from a table built once. The rect array
+// is sized to the batch's capacity on first use, so drawing allocates
+// nothing after that; each painting thread owns its own renderer.
+class ParticleRenderer
+{
+public:
+    ParticleRenderer();
+    void draw(QPainter* painter, const ParticleBatch& batch);
+    void blend(QImage& target, const ParticleBatch& batch, qreal devicePixelRatio) const;
+
+private:
+    QVector<QRectF> rects; // Particles grouped by bucket
+    QColor bucketColors[PARTICLE_BUCKETS];
+    quint32 premultiplied[PARTICLE_SHADES][256]; // Palette color at each alpha
+};
+
+#endif // PARTICLERENDERER_H
@@ -0,0 +1,235 @@
+#include "particles.h"
+#include <algorithm>
+
+// Opaque colors of the palette entries: debris, sparks, smoke and exhaust
+static const quint32 PARTICLE_PALETTE[PARTICLE_SHADES] = {
+    0xFF2B2B2B, // Debris: dark metal
+    0xFF8E1B1B, // Debris: paint
+    0xFFCFE3EA, // Debris: glass
+    0xFFFFA329, // Sparks
+    0xFF474747, // Smoke: dark
+    0xFF707070, // Smoke: light
+    0xFF9C9C9C, // Exhaust: dark
+    0xFFC4C4C4, // Exhaust: light
+};
+
+// Moves, slows, ages, grows and fades count particles by the given time.
+// The columns are parameters so that restrict lets the compiler vectorize,
+// and the loop runs over whole blocks so that it needs no scalar tail; the
+// free slots it also touches are overwritten when they are next used.
+static void integrate(int count, float seconds, float* __restrict x, float* __restrict y, float* __restrict size,
+                      quint8* __restrict alpha, float* __restrict vx, float* __restrict vy, float* __restrict age,
+                      const float* __restrict drag, const float* __restrict lift,
+                      const float* __restrict inverseLife, const float* __restrict growth,
+                      const float* __restrict opacity) {
+    const int padded = (count + PARTICLE_BLOCK - 1) & ~(PARTICLE_BLOCK - 1);
+    for (int i = 0; i < padded; ++i) {
+        const float keep = std::max(0.0f, 1.0f - drag[i] * seconds);
+        vx[i] *= keep;
+        vy[i] = vy[i] * keep + lift[i] * seconds;
+        x[i] += vx[i] * seconds;
+        y[i] += vy[i] * seconds;
+        size[i] += growth[i] * seconds;
+        age[i] += seconds;
+        const float fade = std::max(0.0f, 1.0f - age[i] * inverseLife[i]);
+        alpha[i] = static_cast<quint8>(static_cast<int>(opacity[i] * fade));
+    }
+}
+
+// ===========================
+// ParticleBatch Implementation
+// ===========================
+
+// Sizes every column for capacity particles
+void ParticleBatch::resize(int capacity) {
+    x.resize(capacity);
+    y.resize(capacity);
+    size.resize(capacity);
+    shade.resize(capacity);
+    alpha.resize(capacity);
+}
+
+// Copies the live particles of another batch; allocates only the first time
+void ParticleBatch::copyFrom(const ParticleBatch& other) {
+    if (static_cast<int>(x.size()) < other.count) {
+        resize(static_cast<int>(other.x.size()));
+    }
+    count = other.count;
+    std::copy(other.x.begin(), other.x.begin() + count, x.begin());
+    std::copy(other.y.begin(), other.y.begin() + count, y.begin());
+    std::copy(other.size.begin(), other.size.begin() + count, size.begin());
+    std::copy(other.shade.begin(), other.shade.begin() + count, shade.begin());
+    std::copy(other.alpha.begin(), other.alpha.begin() + count, alpha.begin());
+}
+
+// Returns the area the particles cover, or an empty rect without particles
+QRectF ParticleBatch::bounds() const {
+    if (count == 0) {
+        return QRectF();
+    }
+    float left = x[0] - size[0] / 2;
+    float top = y[0] - size[0] / 2;
+    float right = x[0] + size[0] / 2;
+    float bottom = y[0] + size[0] / 2;
+    for (int i = 1; i < count; ++i) {
+        const float half = size[i] / 2;
+        left = std::min(left, x[i] - half);
+        top = std::min(top, y[i] - half);
+        right = std::max(right, x[i] + half);
+        bottom = std::max(bottom, y[i] + half);
+    }
+    return QRectF(left, top, right - left, bottom - top);
+}
+
+// Returns the opaque color of a palette entry
+quint32 ParticleBatch::shadeColor(int shade) {
+    return PARTICLE_PALETTE[shade];
+}
+
+// ===========================
+// ParticleSystem Class Implementation
+// ===========================
+
+// Constructor allocates the whole pool up front, padded to whole blocks
+ParticleSystem::ParticleSystem(int capacity)
+    : capacity(qMax(0, capacity)),
+    exhaustClock(0.0f),
+    rng(0x9E3779B97F4A7C15ULL)
+{
+    const int padded = (this->capacity + PARTICLE_BLOCK - 1) & ~(PARTICLE_BLOCK - 1);
+    batch.resize(padded);
+    vx.resize(padded);
+    vy.resize(padded);
+    drag.resize(padded);
+    lift.resize(padded);
+    age.resize(padded);
+    inverseLife.resize(padded);
+    growth.resize(padded);
+    opacity.resize(padded);
+}
+
+// Removes every particle
+void ParticleSystem::clear() {
+    batch.count = 0;
+    exhaustClock = 0.0f;
+}
+
+// Throws debris and sparks out of the impact point and lets smoke rise from it
+void ParticleSystem::emitCrash(float x, float y) {
+    for (int i = 0; i < CRASH_DEBRIS; ++i) {
+        // Uniform direction and speed from a point in the unit disc
+        float dx;
+        float dy;
+        do {
+            dx = random(-1.0f, 1.0f);
+            dy = random(-1.0f, 1.0f);
+        } while (dx * dx + dy * dy > 1.0f);
+        const float speed = random(120.0f, 420.0f);
+        spawn(x + random(-20.0f, 20.0f), y + random(-6.0f, 6.0f), dx * speed, dy * speed, 2.5f, 0.0f,
+              random(0.6f, 1.5f), random(2.0f, 5.0f), 0.0f, static_cast<int>(rng.bounded(4)), 255.0f);
+    }
+    for (int i = 0; i < CRASH_SMOKE; ++i) {
+        spawn(x + random(-30.0f, 30.0f), y + random(-10.0f, 20.0f), random(-30.0f, 30.0f), random(-60.0f, -10.0f),
+              0.8f, -20.0f, random(1.4f, 2.6f), random(6.0f, 10.0f), random(8.0f, 14.0f),
+              4 + static_cast<int>(rng.bounded(2)), random(110.0f, 170.0f));
+    }
+}
+
+// Puffs exhaust from a car's tailpipe at (x, y). speed is how fast the road
+// moves down the screen; the puffs stay on the road behind the car.
+void ParticleSystem::emitExhaust(float x, float y, float speed, int puffs) {
+    for (int i = 0; i < puffs; ++i) {
+        spawn(x + random(-6.0f, 6.0f), y + random(-2.0f, 2.0f), random(-8.0f, 8.0f), speed * random(0.9f, 1.0f),
+              0.5f, 0.0f, random(0.5f, 0.8f), 3.0f, 10.0f, 6 + static_cast<int>(rng.bounded(2)),
+              random(90.0f, 140.0f));
+    }
+}
+
+// Returns how many puffs each car emits over the next seconds at EXHAUST_RATE
+int ParticleSystem::exhaustDue(float seconds) {
+    exhaustClock += seconds * EXHAUST_RATE;
+    int puffs = static_cast<int>(exhaustClock);
+    exhaustClock -= puffs;
+    return puffs;
+}
+
+// Advances every particle by the given time and removes the expired ones
+void ParticleSystem::update(float seconds) {
+    const int count = batch.count;
+    integrate(count, seconds, batch.x.data(), batch.y.data(), batch.size.data(), batch.alpha.data(), vx.data(),
+              vy.data(), age.data(), drag.data(), lift.data(), inverseLife.data(), growth.data(), opacity.data());
+    float* px = batch.x.data();
+    float* py = batch.y.data();
+    float* edge = batch.size.data();
+    quint8* alphas = batch.alpha.data();
+    float* velocityX = vx.data();
+    float* velocityY = vy.data();
+    float* ages = age.data();
+    const float* inverse = inverseLife.data();
+
+    // Each expired particle takes the last live one's slot
+    int live = count;
+    for (int i = 0; i < live;) {
+        if (ages[i] * inverse[i] < 1.0f) {
+            ++i;
+            continue;
+        }
+        --live;
+        px[i] = px[live];
+        py[i] = py[live];
+        edge[i] = edge[live];
+        alphas[i] = alphas[live];
+        batch.shade[i] = batch.shade[live];
+        velocityX[i] = velocityX[live];
+        velocityY[i] = velocityY[live];
+        ages[i] = ages[live];
+        drag[i] = drag[live];
+        lift[i] = lift[live];
+        inverseLife[i] = inverseLife[live];
+        growth[i] = growth[live];
+        opacity[i] = opacity[live];
+    }
+    batch.count = live;
+}
+
+// Returns the number of live particles
+int ParticleSystem::size() const {
+    return batch.count;
+}
+
+// Returns the most particles that can be alive at once
+int ParticleSystem::getCapacity() const {
+    return capacity;
+}
+
+// Returns the drawable columns of the live particles
+const ParticleBatch& ParticleSystem::getBatch() const {
+    return batch;
+}
+
+// Appends one particle, or drops it if the pool is full
+void ParticleSystem::spawn(float x, float y, float velocityX, float velocityY, float particleDrag, float particleLift,
+                           float life, float size, float particleGrowth, int particleShade, float particleOpacity) {
+    if (batch.count >= capacity) {
+        return;
+    }
+    const int i = batch.count++;
+    batch.x[i] = x;
+    batch.y[i] = y;
+    batch.size[i] = size;
+    batch.shade[i] = static_cast<quint8>(particleShade);
+    batch.alpha[i] = static_cast<quint8>(particleOpacity);
+    vx[i] = velocityX;
+    vy[i] = velocityY;
+    drag[i] = particleDrag;
+    lift[i] = particleLift;
+    age[i] = 0.0f;
+    inverseLife[i] = 1.0f / life;
+    growth[i] = particleGrowth;
+    opacity[i] = particleOpacity;
+}
+
+// Returns a uniform random value in [low, high)
+float ParticleSystem::random(float low, float high) {
+    return low + (high - low) * static_cast<float>(rng.next() >> 8) * (1.0f / 16777216.0f);
+}
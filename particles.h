@@ -0,0 +1,77 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <QRectF>
+#include <QtGlobal>
+#include <vector>
+#include "rng.h"
+
+#define PARTICLE_CAPACITY 65536 // Pool size; emitters drop particles while it is full
+#define PARTICLE_BLOCK 16 // Columns are padded to whole blocks of this many particles
+#define PARTICLE_SHADES 8 // Entries of the particle palette
+#define EXHAUST_RATE 30.0f // Exhaust puffs per second from each traffic car on screen
+#define PARTICLE_MAX_FRAME_SECONDS 0.1f // Longer frames (stalls) advance the particles by this much
+#define CRASH_DEBRIS 600 // Debris pieces thrown by a crash
+#define CRASH_SMOKE 240 // Smoke puffs rising from a crash
+
+// What a frame draws of the particles: one square per particle, centered
+// on (x, y), in structure-of-arrays layout. Storage is sized once to the
+// pool capacity, so copying a batch into a frame snapshot never allocates.
+struct ParticleBatch {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> size; // Edge length of the square
+    std::vector<quint8> shade; // Index into the palette
+    std::vector<quint8> alpha; // Current opacity, 0 to 255
+    int count = 0;
+
+    void resize(int capacity); // Sizes every column; count is kept
+    void copyFrom(const ParticleBatch& other);
+    QRectF bounds() const;
+    static quint32 shadeColor(int shade); // Opaque 0xAARRGGBB color of a palette entry
+};
+
+// Crash debris and smoke, and exhaust trails behind traffic. Purely visual:
+// it runs on frame time next to the simulation and never affects a run.
+//
+// The pool is allocated once at its capacity. Live particles fill the
+// first count slots of every column; new ones are appended and expired
+// ones are replaced by the last live particle, so emitting and expiring
+// never allocate. update() moves, ages, grows and fades every particle in
+// one flat loop over the columns that the compiler vectorizes; only the
+// removal of expired particles is a scalar pass. The drawable columns
+// live in a ParticleBatch that renderers read directly.
+class ParticleSystem
+{
+public:
+    explicit ParticleSystem(int capacity = PARTICLE_CAPACITY);
+    void clear();
+    void emitCrash(float x, float y);
+    void emitExhaust(float x, float y, float speed, int puffs); // speed: road speed in pixels per second
+    int exhaustDue(float seconds); // Puffs per car this frame; keeps the remainder for the next frame
+    void update(float seconds);
+
+    int size() const;
+    int getCapacity() const;
+    const ParticleBatch& getBatch() const;
+
+private:
+    void spawn(float x, float y, float vx, float vy, float drag, float lift, float life, float size, float growth,
+               int shade, float opacity);
+    float random(float low, float high);
+
+    int capacity;
+    ParticleBatch batch;
+    std::vector<float> vx;
+    std::vector<float> vy;
+    std::vector<float> drag; // Fraction of the velocity lost per second
+    std::vector<float> lift; // Constant vertical acceleration; negative rises
+    std::vector<float> age; // Seconds since the particle was emitted
+    std::vector<float> inverseLife; // 1 / lifetime in seconds
+    std::vector<float> growth; // Edge length gained per second
+    std::vector<float> opacity; // Alpha at birth, fading linearly to 0
+    float exhaustClock; // Fraction of a puff carried over between frames
+    Rng rng;
+};
+
+#endif // PARTICLES_H
@@ -0,0 +1,250 @@
+#include "perfstats.h"
+#include <QFile>
+#include <QJsonDocument>
+#include <QDebug>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+// ===========================
+// LatencyHistogram Class Implementation
+// ===========================
+
+// Constructor creates an empty histogram
+LatencyHistogram::LatencyHistogram() {
+    clear();
+}
+
+// Removes all samples
+void LatencyHistogram::clear() {
+    std::memset(buckets, 0, sizeof(buckets));
+    samples = 0;
+    total = 0;
+    largest = 0;
+}
+
+// Returns the bucket of a duration: exact below 16 ns, then 16 buckets per power of two
+int LatencyHistogram::bucketOf(qint64 nsecs) {
+    if (nsecs < PERF_SUB_BUCKETS) {
+        return nsecs < 0 ? 0 : static_cast<int>(nsecs);
+    }
+    int exponent = 63 - qCountLeadingZeroBits(static_cast<quint64>(nsecs));
+    int sub = static_cast<int>(nsecs >> (exponent - 4)) & (PERF_SUB_BUCKETS - 1);
+    return qMin((exponent - 3) * PERF_SUB_BUCKETS + sub, PERF_BUCKETS - 1);
+}
+
+// Returns the smallest duration of a bucket
+qint64 LatencyHistogram::bucketLower(int bucket) {
+    if (bucket < PERF_SUB_BUCKETS) {
+        return bucket;
+    }
+    int exponent = bucket / PERF_SUB_BUCKETS + 3;
+    return (PERF_SUB_BUCKETS + bucket % PERF_SUB_BUCKETS) * (qint64(1) << (exponent - 4));
+}
+
+// Returns the duration in the middle of a bucket
+qint64 LatencyHistogram::bucketMiddle(int bucket) {
+    if (bucket < PERF_SUB_BUCKETS) {
+        return bucket;
+    }
+    return (bucketLower(bucket) + bucketLower(bucket + 1)) / 2;
+}
+
+// Adds one sample
+void LatencyHistogram::record(qint64 nsecs) {
+    ++buckets[bucketOf(nsecs)];
+    ++samples;
+    total += nsecs;
+    largest = qMax(largest, nsecs);
+}
+
+// Returns the number of samples
+qint64 LatencyHistogram::count() const {
+    return samples;
+}
+
+// Returns the duration below which the given fraction of samples fall
+qint64 LatencyHistogram::percentile(double fraction) const {
+    if (samples == 0) {
+        return 0;
+    }
+    qint64 rank = qMax<qint64>(1, static_cast<qint64>(std::ceil(fraction * samples)));
+    qint64 seen = 0;
+    for (int i = 0; i < PERF_BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return qMin(bucketMiddle(i), largest);
+        }
+    }
+    return largest;
+}
+
+// Returns the largest sample
+qint64 LatencyHistogram::maximum() const {
+    return largest;
+}
+
+// Returns the mean of all samples
+double LatencyHistogram::mean() const {
+    return samples == 0 ? 0.0 : static_cast<double>(total) / samples;
+}
+
+// Returns the summary of the histogram in microseconds
+QJsonObject LatencyHistogram::toJson() const {
+    QJsonObject object;
+    object["count"] = samples;
+    object["mean_us"] = mean() / 1000.0;
+    object["p50_us"] = percentile(0.50) / 1000.0;
+    object["p95_us"] = percentile(0.95) / 1000.0;
+    object["p99_us"] = percentile(0.99) / 1000.0;
+    object["max_us"] = largest / 1000.0;
+    return object;
+}
+
+// Returns the non-empty buckets as [from, to) ranges in microseconds with their counts
+QJsonArray LatencyHistogram::bucketsToJson() const {
+    QJsonArray array;
+    for (int i = 0; i < PERF_BUCKETS; ++i) {
+        if (buckets[i] == 0) {
+            continue;
+        }
+        array.append(QJsonObject{
+            {"from_us", bucketLower(i) / 1000.0},
+            {"to_us", bucketLower(i + 1) / 1000.0},
+            {"count", static_cast<qint64>(buckets[i])},
+        });
+    }
+    return array;
+}
+
+// ===========================
+// PerfStats Class Implementation
+// ===========================
+
+// Constructor starts an empty measurement
+PerfStats::PerfStats() {
+    clear();
+}
+
+// Drops all samples and counters and restarts the tick rate clock
+void PerfStats::clear() {
+    for (LatencyHistogram& histogram : histograms) {
+        histogram.clear();
+    }
+    ticks = 0;
+    lateTicks = 0;
+    droppedTicks = 0;
+    missedFrames = 0;
+    startTime = now();
+}
+
+// Returns a monotonic timestamp in nanoseconds
+qint64 PerfStats::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Adds a duration to a phase
+void PerfStats::record(PerfPhase phase, qint64 nsecs) {
+    histograms[static_cast<int>(phase)].record(nsecs);
+}
+
+// Counts one simulation tick
+void PerfStats::countTick(bool late) {
+    ++ticks;
+    if (late) {
+        ++lateTicks;
+    }
+}
+
+// Counts ticks that were skipped instead of simulated
+void PerfStats::countDroppedTicks(qint64 count) {
+    droppedTicks += count;
+}
+
+// Counts display refreshes that showed no new frame
+void PerfStats::countMissedFrames(qint64 count) {
+    missedFrames += count;
+}
+
+// Returns the histogram of a phase
+const LatencyHistogram& PerfStats::getHistogram(PerfPhase phase) const {
+    return histograms[static_cast<int>(phase)];
+}
+
+// Returns the display and JSON name of a phase
+const char* PerfStats::phaseName(PerfPhase phase) {
+    switch (phase) {
+    case PerfPhase::Frame: return "frame";
+    case PerfPhase::Tick: return "tick";
+    case PerfPhase::Collision: return "collision";
+    case PerfPhase::Spawn: return "spawn";
+    case PerfPhase::Render: return "render";
+    case PerfPhase::InputToTick: return "input_tick";
+    case PerfPhase::InputToPhoton: return "input_photon";
+    case PerfPhase::Present: return "present";
+    default: return "unknown";
+    }
+}
+
+// Returns the number of ticks simulated
+qint64 PerfStats::getTicks() const {
+    return ticks;
+}
+
+// Returns the number of ticks that ran late
+qint64 PerfStats::getLateTicks() const {
+    return lateTicks;
+}
+
+// Returns the number of ticks that were skipped
+qint64 PerfStats::getDroppedTicks() const {
+    return droppedTicks;
+}
+
+// Returns the number of display refreshes that showed no new frame
+qint64 PerfStats::getMissedFrames() const {
+    return missedFrames;
+}
+
+// Returns the measured tick rate
+double PerfStats::getTickRate() const {
+    qint64 wall = now() - startTime;
+    return wall <= 0 ? 0.0 : ticks * 1e9 / wall;
+}
+
+// Returns every phase and counter as a JSON object
+QJsonObject PerfStats::toJson() const {
+    QJsonObject phases;
+    for (int i = 0; i < static_cast<int>(PerfPhase::Count); ++i) {
+        phases[phaseName(static_cast<PerfPhase>(i))] = histograms[i].toJson();
+    }
+
+    QJsonObject object;
+    object["phases"] = phases;
+    object["ticks"] = ticks;
+    object["late_ticks"] = lateTicks;
+    object["dropped_ticks"] = droppedTicks;
+    object["missed_frames"] = missedFrames;
+    object["present_intervals"] = histograms[static_cast<int>(PerfPhase::Present)].bucketsToJson();
+    object["tick_rate"] = getTickRate();
+    object["wall_seconds"] = (now() - startTime) / 1e9;
+    return object;
+}
+
+// Writes the summary merged with caller context (machine, build, settings) as indented JSON
+bool PerfStats::writeJson(const QString& path, const QJsonObject& context) const {
+    QJsonObject object = context;
+    const QJsonObject stats = toJson();
+    for (auto it = stats.constBegin(); it != stats.constEnd(); ++it) {
+        object.insert(it.key(), it.value());
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Failed to write performance summary to" << path;
+        return false;
+    }
+    file.write(QJsonDocument(object).toJson(QJsonDocument::Indented));
+    return true;
+}
@@ -0,0 +1,86 @@
+#ifndef PERFSTATS_H
+#define PERFSTATS_H
+
+#include <QtGlobal>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+
+#define PERF_SUB_BUCKETS 16 // Buckets per power of two, about 6% resolution
+#define PERF_BUCKETS (37 * PERF_SUB_BUCKETS) // Covers 0 ns to about 2^40 ns (18 minutes)
+
+// Fixed-size log-linear histogram of durations in nanoseconds. Recording is
+// a few integer operations and never allocates; percentiles are resolved to
+// the middle of their bucket.
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+    void clear();
+    void record(qint64 nsecs);
+    qint64 count() const;
+    qint64 percentile(double fraction) const;
+    qint64 maximum() const;
+    double mean() const;
+    QJsonObject toJson() const; // Count, mean, p50, p95, p99 and max in microseconds
+    QJsonArray bucketsToJson() const; // Range in microseconds and count of each non-empty bucket
+
+private:
+    static int bucketOf(qint64 nsecs);
+    static qint64 bucketLower(int bucket);
+    static qint64 bucketMiddle(int bucket);
+
+    quint32 buckets[PERF_BUCKETS];
+    qint64 samples;
+    qint64 total;
+    qint64 largest;
+};
+
+// Phases timed by PerfStats
+enum class PerfPhase : unsigned char {
+    Frame, // Interval between two frame timer ticks
+    Tick, // One whole Simulation::step
+    Collision, // Collision check inside a step
+    Spawn, // Respawning cars that left the screen inside a step
+    Render, // Game::paintEvent
+    InputToTick, // Key press to the simulation tick that applied it
+    InputToPhoton, // Key press to the end of the first paint showing its effect
+    Present, // Interval between two presented frames
+    Count
+};
+
+// Per-phase histograms and tick counters for the performance overlay and
+// the JSON summary. Fed from the GUI thread only.
+class PerfStats
+{
+public:
+    PerfStats();
+    void clear();
+    static qint64 now(); // Monotonic clock in nanoseconds
+
+    void record(PerfPhase phase, qint64 nsecs);
+    void countTick(bool late);
+    void countDroppedTicks(qint64 count);
+    void countMissedFrames(qint64 count);
+
+    const LatencyHistogram& getHistogram(PerfPhase phase) const;
+    static const char* phaseName(PerfPhase phase);
+    qint64 getTicks() const;
+    qint64 getLateTicks() const;
+    qint64 getDroppedTicks() const;
+    qint64 getMissedFrames() const;
+    double getTickRate() const; // Ticks per second of wall time since clear()
+
+    QJsonObject toJson() const;
+    bool writeJson(const QString& path, const QJsonObject& context) const;
+
+private:
+    LatencyHistogram histograms[static_cast<int>(PerfPhase::Count)];
+    qint64 ticks;
+    qint64 lateTicks; // Ticks that ran more than one step behind the wall clock
+    qint64 droppedTicks; // Ticks skipped when a stall exceeded the backlog clamp
+    qint64 missedFrames; // Display refreshes that showed no new frame
+    qint64 startTime;
+};
+
+#endif // PERFSTATS_H
@@ -0,0 +1,45 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <QtGlobal>
+
+// Small, fast, seedable PRNG (PCG32, XSH-RR variant). Each game owns its own
+// instance, so runs are reproducible from the seed and the state is a plain
+// value that can be copied with the rest of the simulation. Defined inline
+// because it is called on the spawn path.
+class Rng
+{
+public:
+    explicit Rng(quint64 seed = 0) { reseed(seed); }
+
+    // Restarts the sequence for the given seed
+    void reseed(quint64 seed) {
+        state = 0;
+        next();
+        state += seed;
+        next();
+    }
+
+    // Returns the next 32 random bits
+    quint32 next() {
+        quint64 old = state;
+        state = old * 6364136223846793005ULL + 1442695040888963407ULL;
+        quint32 xorShifted = static_cast<quint32>(((old >> 18) ^ old) >> 27);
+        quint32 rotation = static_cast<quint32>(old >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+    }
+
+    // Raw generator state, for snapshots
+    quint64 getState() const { return state; }
+    void setState(quint64 value) { state = value; }
+
+    // Returns a value in [0, bound) using a multiply-shift reduction (no division)
+    quint32 bounded(quint32 bound) {
+        return static_cast<quint32>((quint64(next()) * bound) >> 32);
+    }
+
+private:
+    quint64 state;
+};
+
+#endif // RNG_H
@@ -0,0 +1,172 @@
+#include "runlog.h"
+#include <QDataStream>
+#include <QFile>
+#include <QDebug>
+#include "simulation.h"
+
+// ===========================
+// RunLog Class Implementation
+// ===========================
+
+// Constructor creates an empty log for the default road
+RunLog::RunLog()
+    : seed(0),
+    stepMs(SIM_STEP_MS),
+    laneCount(DEFAULT_LANE_COUNT),
+    trafficCount(DEFAULT_TRAFFIC_COUNT),
+    laneChangeTicks(0)
+{
+}
+
+// Starts recording a new run
+void RunLog::begin(quint64 runSeed, int runStepMs, int runLaneCount, int runTrafficCount, int runLaneChangeTicks) {
+    seed = runSeed;
+    stepMs = runStepMs;
+    laneCount = runLaneCount;
+    trafficCount = runTrafficCount;
+    laneChangeTicks = runLaneChangeTicks;
+    events.clear();
+    outcome = RunOutcome();
+}
+
+// Appends a steering event
+void RunLog::record(quint32 tick, quint32 receivedAt, int steer) {
+    events.append(RunLogEvent{tick, receivedAt, static_cast<qint8>(steer < 0 ? -1 : 1)});
+}
+
+// Stores how the run ended
+void RunLog::finish(const RunOutcome &runOutcome) {
+    outcome = runOutcome;
+}
+
+// Writes the log as little-endian binary
+bool RunLog::save(const QString &path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write run log" << path;
+        return false;
+    }
+    QDataStream out(&file);
+    out.setByteOrder(QDataStream::LittleEndian);
+
+    out << quint32(RUN_LOG_MAGIC) << quint16(RUN_LOG_VERSION) << quint16(stepMs)
+        << quint16(laneCount) << quint32(trafficCount) << seed << quint16(laneChangeTicks);
+    out << quint32(events.size());
+    for (const RunLogEvent& event : events) {
+        out << event.tick << event.receivedAt << event.steer;
+    }
+    out << quint8(outcome.crashed) << outcome.crashTick << qint16(outcome.playerLane) << qint64(outcome.elapsed);
+    return out.status() == QDataStream::Ok;
+}
+
+// Reads a log written by save()
+bool RunLog::load(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open run log" << path;
+        return false;
+    }
+    QDataStream in(&file);
+    in.setByteOrder(QDataStream::LittleEndian);
+
+    quint32 magic;
+    quint16 version, step, lanes;
+    quint32 traffic, eventCount;
+    in >> magic >> version >> step >> lanes >> traffic >> seed;
+    if (magic != RUN_LOG_MAGIC || version > RUN_LOG_VERSION) {
+        qWarning() << "Not a run log or unsupported version:" << path;
+        return false;
+    }
+    if (version < RUN_LOG_MIN_VERSION) {
+        const char* rule = version < 3 ? "collisions were swept through each step"
+                                       : "collisions were decided by pixel masks";
+        qWarning() << "Run log" << path << "has version" << version << "and was recorded before" << rule
+                   << "- the collision rules changed, so it cannot be replayed";
+        return false;
+    }
+    stepMs = step;
+    laneCount = lanes;
+    trafficCount = traffic;
+
+    quint16 laneChange;
+    in >> laneChange;
+    laneChangeTicks = laneChange;
+
+    in >> eventCount;
+    events.clear();
+    events.reserve(eventCount);
+    for (quint32 i = 0; i < eventCount && in.status() == QDataStream::Ok; ++i) {
+        RunLogEvent event;
+        in >> event.tick >> event.receivedAt >> event.steer;
+        events.append(event);
+    }
+
+    quint8 crashed;
+    qint16 lane;
+    qint64 elapsed;
+    in >> crashed >> outcome.crashTick >> lane >> elapsed;
+    outcome.crashed = crashed != 0;
+    outcome.playerLane = lane;
+    outcome.elapsed = elapsed;
+    return in.status() == QDataStream::Ok;
+}
+
+// Re-executes the run through the simulation with no rendering. Stops at the
+// crash, or after maxTicks steps if maxTicks is not 0.
+RunOutcome RunLog::replay(quint32 maxTicks) const {
+    Simulation simulation(laneCount, trafficCount, seed);
+    simulation.setLaneChangeTicks(laneChangeTicks);
+    int next = 0;
+
+    while (!simulation.isCrashed() && (maxTicks == 0 || simulation.getTick() < maxTicks)) {
+        // Events are stored in tick order; apply the ones for the coming step
+        SimInput input;
+        while (next < events.size() && events[next].tick <= simulation.getTick()) {
+            input.steer = events[next].steer;
+            ++next;
+        }
+        simulation.step(stepMs, input);
+    }
+
+    RunOutcome result;
+    result.crashed = simulation.isCrashed();
+    result.crashTick = simulation.getTick();
+    result.playerLane = simulation.getPlayerLane();
+    result.elapsed = simulation.getElapsed();
+    return result;
+}
+
+// Returns the seed of the recorded run
+quint64 RunLog::getSeed() const {
+    return seed;
+}
+
+// Returns the fixed timestep of the recorded run in milliseconds
+int RunLog::getStepMs() const {
+    return stepMs;
+}
+
+// Returns the number of lanes of the recorded run
+int RunLog::getLaneCount() const {
+    return laneCount;
+}
+
+// Returns the number of traffic cars of the recorded run
+int RunLog::getTrafficCount() const {
+    return trafficCount;
+}
+
+// Returns how many ticks a lane change took in the recorded run
+int RunLog::getLaneChangeTicks() const {
+    return laneChangeTicks;
+}
+
+// Returns the recorded steering events in tick order
+const QVector<RunLogEvent>& RunLog::getEvents() const {
+    return events;
+}
+
+// Returns the recorded outcome
+const RunOutcome& RunLog::getOutcome() const {
+    return outcome;
+}
@@ -0,0 +1,63 @@
+#ifndef RUNLOG_H
+#define RUNLOG_H
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+#define RUN_LOG_MAGIC 0x4C524743 // "CGRL" read as little-endian
+#define RUN_LOG_VERSION 4 // Version 2 added the lane change duration; 3 marks swept collisions, 4 pixel masks
+#define RUN_LOG_MIN_VERSION 4 // Older logs were recorded under other collision rules and cannot replay
+#define RUN_LOG_REPLAY_SLACK_TICKS 1000 // Ticks a replay may run past the recorded crash before it is cut off
+
+// Steering input as received by Game::keyPressEvent
+struct RunLogEvent {
+    quint32 tick; // Simulation tick the input was applied on
+    quint32 receivedAt; // Milliseconds since the run started when the key arrived
+    qint8 steer; // -1 left, +1 right
+};
+
+// How a run (or its replay) ended
+struct RunOutcome {
+    bool crashed = false;
+    quint32 crashTick = 0;
+    int playerLane = 0;
+    qint64 elapsed = 0; // Simulated milliseconds at the crash
+};
+
+// Compact binary record of one run: the seed and road layout, the timestep,
+// the lane change duration and every steering event. The simulation is deterministic for a given
+// seed and input sequence, so replay() reproduces the run exactly and can
+// be checked against the recorded outcome.
+class RunLog
+{
+public:
+    RunLog();
+    void begin(quint64 seed, int stepMs, int laneCount, int trafficCount, int laneChangeTicks = 0);
+    void record(quint32 tick, quint32 receivedAt, int steer);
+    void finish(const RunOutcome& outcome);
+
+    bool save(const QString& path) const;
+    bool load(const QString& path);
+
+    RunOutcome replay(quint32 maxTicks = 0) const;
+
+    quint64 getSeed() const;
+    int getStepMs() const;
+    int getLaneCount() const;
+    int getTrafficCount() const;
+    int getLaneChangeTicks() const;
+    const QVector<RunLogEvent>& getEvents() const;
+    const RunOutcome& getOutcome() const;
+
+private:
+    quint64 seed;
+    int stepMs;
+    int laneCount;
+    int trafficCount;
+    int laneChangeTicks;
+    QVector<RunLogEvent> events;
+    RunOutcome outcome;
+};
+
+#endif // RUNLOG_H
@@ -0,0 +1,340 @@
+#include "scorestore.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QThread>
+#include <cstddef>
+#include <cstring>
+#include "gamelog.h"
+#include "trace.h"
+
+// Header at the start of the log file; records follow back to back
+struct ScoreLogHeader {
+    quint32 magic;
+    quint32 version;
+    quint32 recordSize;
+    quint32 reserved;
+};
+
+// FNV-1a over a block of bytes; cheap and good enough to spot torn writes
+static quint32 checksumBytes(const void* data, size_t size) {
+    const uchar* bytes = static_cast<const uchar*>(data);
+    quint32 hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Returns the checksum a record should carry
+static quint32 recordChecksum(const ScoreRecord& record) {
+    return checksumBytes(&record, offsetof(ScoreRecord, checksum));
+}
+
+// ===========================
+// ScoreBoard Implementation
+// ===========================
+
+// Empties both leaderboards
+void ScoreBoard::clear() {
+    std::memset(this, 0, sizeof(ScoreBoard));
+}
+
+// Folds one run into the all-time top list and its day's slot
+void ScoreBoard::add(const ScoreRecord& record) {
+    // Insert into the top list, which is sorted best first
+    quint32 position = topCount;
+    while (position > 0 && top[position - 1].finalTime < record.finalTime) {
+        --position;
+    }
+    if (position < SCORE_TOP_COUNT) {
+        quint32 last = qMin<quint32>(topCount, SCORE_TOP_COUNT - 1);
+        for (quint32 i = last; i > position; --i) {
+            top[i] = top[i - 1];
+        }
+        top[position] = record;
+        topCount = qMin<quint32>(topCount + 1, SCORE_TOP_COUNT);
+    }
+
+    // A newer day takes over the slot of the day SCORE_DAY_COUNT days before it
+    if (record.day <= 0) {
+        return;
+    }
+    ScoreRecord& slot = days[record.day % SCORE_DAY_COUNT];
+    if (slot.day < record.day || (slot.day == record.day && slot.finalTime < record.finalTime)) {
+        slot = record;
+    }
+}
+
+// Returns the best time of all runs, or 0 without runs
+double ScoreBoard::bestTime() const {
+    return topCount > 0 ? top[0].finalTime : 0.0;
+}
+
+// Returns the best run of a day (Julian day number), or null if none is kept
+const ScoreRecord* ScoreBoard::bestOfDay(qint32 day) const {
+    if (day <= 0) {
+        return nullptr;
+    }
+    const ScoreRecord& slot = days[day % SCORE_DAY_COUNT];
+    return slot.day == day ? &slot : nullptr;
+}
+
+// ===========================
+// ScoreStore Class Implementation
+// ===========================
+
+// Constructor creates a closed store with empty leaderboards
+ScoreStore::ScoreStore()
+    : indexMap(nullptr),
+    runCount(0),
+    writer(nullptr),
+    stopping(false)
+{
+    board.clear();
+}
+
+// Destructor writes the queued runs and closes the files
+ScoreStore::~ScoreStore() {
+    close();
+}
+
+// Opens or creates the log and index in the given directory, brings the
+// index up to date and starts the writer. Returns false if the files cannot
+// be used; runs are then still ranked, but only for this session.
+bool ScoreStore::open(const QString& directory) {
+    close();
+    QDir().mkpath(directory);
+    if (!openLog(directory + "/scores.log") || !openIndex(directory + "/scores.idx")) {
+        logFile.close();
+        indexFile.close();
+        indexMap = nullptr;
+        return false;
+    }
+
+    // Fold in runs the index missed, e.g. after a crash between the two writes
+    const IndexHeader* header = indexHeader();
+    if (header->indexedRecords < runCount) {
+        LOG_INFO(Game, "Indexing %.0f runs missing from the score index.", runCount - header->indexedRecords);
+        foldRecords(header->indexedRecords, runCount);
+        commitIndex(runCount);
+    }
+    board = *indexBoard();
+    LOG_INFO(Game, "Score store opened with %.0f runs.", runCount);
+
+    stopping = false;
+    writer = QThread::create([this]() { run(); });
+    writer->start();
+    return true;
+}
+
+// Opens the log, writes the header of a new log and drops a torn record at its end
+bool ScoreStore::openLog(const QString& path) {
+    logFile.setFileName(path);
+    if (!logFile.open(QIODevice::ReadWrite)) {
+        qWarning() << "Failed to open score log" << path;
+        return false;
+    }
+
+    ScoreLogHeader header;
+    if (logFile.size() < static_cast<qint64>(sizeof(header))) {
+        header = ScoreLogHeader{SCORE_LOG_MAGIC, SCORE_STORE_VERSION, sizeof(ScoreRecord), 0};
+        logFile.resize(0);
+        if (logFile.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header)) {
+            qWarning() << "Failed to write score log" << path;
+            return false;
+        }
+        logFile.flush();
+    } else if (logFile.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header) ||
+               header.magic != SCORE_LOG_MAGIC || header.version != SCORE_STORE_VERSION ||
+               header.recordSize != sizeof(ScoreRecord)) {
+        qWarning() << "Not a score log or unsupported version:" << path;
+        return false;
+    }
+
+    // A crash mid-append leaves a partial record; the next append overwrites it
+    qint64 payload = logFile.size() - static_cast<qint64>(sizeof(header));
+    runCount = static_cast<quint64>(payload) / sizeof(ScoreRecord);
+    if (payload % static_cast<qint64>(sizeof(ScoreRecord)) != 0) {
+        logFile.resize(static_cast<qint64>(sizeof(header) + runCount * sizeof(ScoreRecord)));
+    }
+    return logFile.seek(logFile.size());
+}
+
+// Maps the index file and rebuilds it from the log if it is new or damaged
+bool ScoreStore::openIndex(const QString& path) {
+    indexFile.setFileName(path);
+    if (!indexFile.open(QIODevice::ReadWrite)) {
+        qWarning() << "Failed to open score index" << path;
+        return false;
+    }
+
+    const qint64 size = sizeof(IndexHeader) + sizeof(ScoreBoard);
+    bool valid = indexFile.size() == size;
+    if (!valid && !indexFile.resize(size)) {
+        qWarning() << "Failed to size score index" << path;
+        return false;
+    }
+    indexMap = indexFile.map(0, size);
+    if (!indexMap) {
+        qWarning() << "Failed to map score index" << path;
+        return false;
+    }
+
+    const IndexHeader* header = indexHeader();
+    valid = valid && header->magic == SCORE_INDEX_MAGIC && header->version == SCORE_STORE_VERSION &&
+            header->indexedRecords <= runCount &&
+            header->boardChecksum == checksumBytes(indexBoard(), sizeof(ScoreBoard));
+    if (!valid) {
+        rebuildIndex();
+    }
+    return true;
+}
+
+// Reads the record at a position in the log; false if it is unreadable or torn
+bool ScoreStore::readRecord(quint64 position, ScoreRecord& record) {
+    qint64 offset = static_cast<qint64>(sizeof(ScoreLogHeader) + position * sizeof(ScoreRecord));
+    return logFile.seek(offset) &&
+           logFile.read(reinterpret_cast<char*>(&record), sizeof(record)) == sizeof(record) &&
+           record.checksum == recordChecksum(record);
+}
+
+// Folds the log records in [first, last) into the mapped board
+void ScoreStore::foldRecords(quint64 first, quint64 last) {
+    ScoreBoard* mapped = indexBoard();
+    ScoreRecord record;
+    for (quint64 i = first; i < last; ++i) {
+        if (readRecord(i, record)) {
+            mapped->add(record);
+        } else {
+            LOG_INFO(Game, "Skipped damaged score record %.0f.", i);
+        }
+    }
+    logFile.seek(logFile.size());
+}
+
+// Recomputes the leaderboards from the whole log
+void ScoreStore::rebuildIndex() {
+    LOG_INFO(Game, "Rebuilding the score index from %.0f runs.", runCount);
+    indexBoard()->clear();
+    foldRecords(0, runCount);
+    commitIndex(runCount);
+}
+
+// Stamps the mapped board as covering the first indexedRecords log records.
+// The checksum is written last, so a crash during an update is caught on open.
+void ScoreStore::commitIndex(quint64 indexedRecords) {
+    IndexHeader* header = indexHeader();
+    header->magic = SCORE_INDEX_MAGIC;
+    header->version = SCORE_STORE_VERSION;
+    header->indexedRecords = indexedRecords;
+    header->reserved = 0;
+    header->boardChecksum = checksumBytes(indexBoard(), sizeof(ScoreBoard));
+}
+
+// Returns the header of the mapped index
+ScoreStore::IndexHeader* ScoreStore::indexHeader() const {
+    return reinterpret_cast<IndexHeader*>(indexMap);
+}
+
+// Returns the board of the mapped index
+ScoreBoard* ScoreStore::indexBoard() const {
+    return reinterpret_cast<ScoreBoard*>(indexMap + sizeof(IndexHeader));
+}
+
+// Writes the queued runs, stops the writer and unmaps the index
+void ScoreStore::close() {
+    if (writer) {
+        {
+            QMutexLocker locker(&mutex);
+            stopping = true;
+            queueChanged.wakeOne();
+        }
+        writer->wait();
+        delete writer;
+        writer = nullptr;
+    }
+    if (indexMap) {
+        indexFile.unmap(indexMap);
+        indexMap = nullptr;
+    }
+    indexFile.close();
+    logFile.close();
+}
+
+// Returns true if runs are being written to disk
+bool ScoreStore::isOpen() const {
+    return writer != nullptr;
+}
+
+// Ranks a finished run at once and queues it for the writer; never touches the disk
+void ScoreStore::submit(const ScoreRecord& record) {
+    board.add(record);
+    ++runCount;
+    if (!writer) {
+        return;
+    }
+    QMutexLocker locker(&mutex);
+    queue.append(record);
+    queueChanged.wakeOne();
+}
+
+// Returns the leaderboards including runs not yet on disk
+const ScoreBoard& ScoreStore::getBoard() const {
+    return board;
+}
+
+// Returns the number of runs stored, including queued ones
+quint64 ScoreStore::getRunCount() const {
+    return runCount;
+}
+
+// Builds a checksummed record for a run that ended at endedAt (ms since the epoch)
+ScoreRecord ScoreStore::makeRecord(double finalTime, quint64 seed, int level, qint64 endedAt) {
+    ScoreRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.finalTime = finalTime;
+    record.seed = seed;
+    record.endedAt = endedAt;
+    record.level = level;
+    record.day = static_cast<qint32>(QDateTime::fromMSecsSinceEpoch(endedAt).date().toJulianDay());
+    record.checksum = recordChecksum(record);
+    return record;
+}
+
+// Writer loop: appends queued runs to the log, flushes it to the OS and
+// then updates the mapped index. Finishes the queue before stopping.
+void ScoreStore::run() {
+    Trace::setThreadName("score writer");
+    QVector<ScoreRecord> batch;
+    quint64 indexed = indexHeader()->indexedRecords;
+    forever {
+        {
+            QMutexLocker locker(&mutex);
+            while (queue.isEmpty() && !stopping) {
+                queueChanged.wait(&mutex);
+            }
+            if (queue.isEmpty()) {
+                return;
+            }
+            std::swap(batch, queue);
+        }
+
+        TRACE_SCOPE("scores", "append");
+        qint64 bytes = batch.size() * static_cast<qint64>(sizeof(ScoreRecord));
+        if (logFile.write(reinterpret_cast<const char*>(batch.constData()), bytes) != bytes || !logFile.flush()) {
+            // Cut off whatever part of the batch made it, so records stay aligned
+            qWarning() << "Failed to append to score log" << logFile.fileName();
+            logFile.resize(static_cast<qint64>(sizeof(ScoreLogHeader) + indexed * sizeof(ScoreRecord)));
+            logFile.seek(logFile.size());
+            batch.clear();
+            continue;
+        }
+        for (const ScoreRecord& record : batch) {
+            indexBoard()->add(record);
+        }
+        indexed += batch.size();
+        commitIndex(indexed);
+        batch.clear();
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef SCORESTORE_H
+#define SCORESTORE_H
+
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <QWaitCondition>
+#include <QtGlobal>
+#include <type_traits>
+
+class QThread;
+
+#define SCORE_LOG_MAGIC 0x4C534743 // "CGSL" read as little-endian
+#define SCORE_INDEX_MAGIC 0x49534743 // "CGSI" read as little-endian
+#define SCORE_STORE_VERSION 1
+#define SCORE_TOP_COUNT 10 // Runs kept on the all-time leaderboard
+#define SCORE_DAY_COUNT 366 // Days of per-day bests kept in the index
+
+// One finished run as stored in the log. Fixed size and written as raw
+// bytes, so the n-th run is at a known offset and a torn write at the end
+// of the file is detected by its checksum.
+struct ScoreRecord {
+    double finalTime; // Seconds survived
+    quint64 seed;
+    qint64 endedAt; // Milliseconds since the epoch, UTC
+    qint32 level; // Difficulty level reached
+    qint32 day; // Local calendar day the run ended on, as a Julian day number
+    quint32 checksum; // Over all fields above
+    quint32 reserved;
+};
+
+static_assert(sizeof(ScoreRecord) == 40, "ScoreRecord is a fixed on-disk record");
+
+// Leaderboards folded from the log: the best runs of all time, best first,
+// and the best run of each of the last SCORE_DAY_COUNT days, each in the
+// slot day % SCORE_DAY_COUNT. It has a fixed size, so the index file is the
+// raw struct and startup cost does not grow with the number of runs.
+struct ScoreBoard {
+    quint32 topCount;
+    ScoreRecord top[SCORE_TOP_COUNT];
+    ScoreRecord days[SCORE_DAY_COUNT]; // Slots whose day is 0 are empty
+
+    void clear();
+    void add(const ScoreRecord& record);
+    double bestTime() const;
+    const ScoreRecord* bestOfDay(qint32 day) const;
+};
+
+static_assert(std::is_trivially_copyable<ScoreBoard>::value, "ScoreBoard is mapped from disk");
+
+// Persistent history of every run. Runs are appended to a fixed-record log
+// (scores.log) and folded into a memory-mapped leaderboard index
+// (scores.idx). The GUI thread only queues records; a background writer
+// appends them, flushes and updates the mapped index, so a crash never
+// waits on the disk. The index remembers how many log records it covers:
+// on open, only records written after it are folded in, and a missing or
+// damaged index is rebuilt from the log once.
+class ScoreStore
+{
+public:
+    ScoreStore();
+    ~ScoreStore();
+
+    bool open(const QString& directory);
+    void close();
+    bool isOpen() const;
+
+    void submit(const ScoreRecord& record);
+
+    const ScoreBoard& getBoard() const;
+    quint64 getRunCount() const;
+
+    static ScoreRecord makeRecord(double finalTime, quint64 seed, int level, qint64 endedAt);
+
+private:
+    // Header at the start of the index file, followed by the ScoreBoard
+    struct IndexHeader {
+        quint32 magic;
+        quint32 version;
+        quint64 indexedRecords; // Log records folded into the board
+        quint32 boardChecksum;
+        quint32 reserved;
+    };
+
+    bool openLog(const QString& path);
+    bool openIndex(const QString& path);
+    bool readRecord(quint64 position, ScoreRecord& record);
+    void foldRecords(quint64 first, quint64 last);
+    void rebuildIndex();
+    void commitIndex(quint64 indexedRecords);
+    IndexHeader* indexHeader() const;
+    ScoreBoard* indexBoard() const;
+    void run();
+
+    QFile logFile;
+    QFile indexFile;
+    uchar* indexMap; // IndexHeader followed by the ScoreBoard, or null if unmapped
+    ScoreBoard board; // GUI-side copy, updated as soon as a run is submitted
+    quint64 runCount;
+
+    QThread* writer;
+    QMutex mutex;
+    QWaitCondition queueChanged;
+    QVector<ScoreRecord> queue; // Records waiting for the writer, guarded by mutex
+    bool stopping;
+};
+
+#endif // SCORESTORE_H
@@ -0,0 +1,332 @@
+#include "simulation.h"
+#include "gamelog.h"
+#include "collisionmask.h"
+#include "trace.h"
+#include <cmath>
+#include <algorithm>
+
+// ===========================
+// Simulation Class Implementation
+// ===========================
+
+// Constructor puts the simulation into its initial state
+Simulation::Simulation(int laneCount, int trafficCount, quint64 seed)
+    : mainCar(SpriteId::Player),
+    playerLane(0),
+    laneChangeTicks(0),
+    laneChangeFrom(0),
+    laneChangeProgress(0),
+    traffic(laneCount),
+    rng(seed),
+    seed(seed),
+    trafficCount(trafficCount),
+    level(2),
+    crashed(false),
+    finalTime(0.0),
+    stepStartX(0),
+    stepTravel(0.0f),
+    elapsed(0),
+    tick(0),
+    roadDistance(0.0),
+    perfStats(nullptr)
+{
+    reset();
+}
+
+// Changes the road layout and starts a new run with it
+void Simulation::configure(int laneCount, int count) {
+    traffic.setLaneCount(laneCount);
+    trafficCount = count;
+    reset();
+}
+
+// Restarts the current run from its seed
+void Simulation::reset() {
+    reset(seed);
+}
+
+// Resets the simulation to the start of a new run with the given seed
+void Simulation::reset(quint64 newSeed) {
+    seed = newSeed;
+    rng.reseed(seed);
+    crashed = false;
+    finalTime = 0.0;
+    elapsed = 0;
+    tick = 0;
+    roadDistance = 0.0;
+    level = 2;
+
+    // Initialize main car position
+    playerLane = traffic.getLaneCount() / 2; // Centered horizontally
+    mainCar.setX(Traffic::laneToX(playerLane, traffic.getLaneCount()));
+    laneChangeFrom = mainCar.getX();
+    laneChangeProgress = laneChangeTicks;
+    stepStartX = mainCar.getX();
+    stepTravel = 0.0f;
+    mainCar.setY(WINDOWS_SIZE_Y - CAR_SIZE_Y - 20); // Positioned near the bottom
+    mainCar.setSprite(SpriteId::Player);
+
+    // Set initial positions for secondary cars in different lanes
+    initializeCarPositions();
+    LOG_INFO(Simulation, "Simulation reset with %.0f lanes, %.0f cars and seed %.0f * 2^32 + %.0f.",
+             traffic.getLaneCount(), trafficCount, static_cast<quint32>(seed >> 32), static_cast<quint32>(seed));
+}
+
+// Spreads the traffic cars over the lanes, stacked above the screen
+void Simulation::initializeCarPositions() {
+    traffic.clear();
+    traffic.reserve(trafficCount);
+    broadPhase.reset(traffic.getLaneCount());
+    wrapped.reserve(trafficCount);
+    for (int i = 0; i < trafficCount; ++i) {
+        int index = traffic.add(i % traffic.getLaneCount(), 0.0f);
+        broadPhase.insert(traffic, index);
+        respawnCar(index);
+    }
+}
+
+// Returns the fraction of the current step at which the player first hit
+// traffic, or -1 if it did not. Each car is swept from its previous to its
+// current Y and the player from its X at the start of the step, so a car
+// that passes through the player within one step is caught at any speed;
+// the sprites' collision masks decide whether they really touch.
+float Simulation::checkCollision() const {
+    const CollisionMask& playerMask = CollisionMask::forSprite(mainCar.getSprite());
+    const float mainY = mainCar.getY();
+    const int endX = mainCar.getX();
+    const int leftX = std::min(stepStartX, endX);
+    const int rightX = std::max(stepStartX, endX);
+
+    float impact = -1.0f;
+    for (int lane = 0; lane < traffic.getLaneCount(); ++lane) {
+        const int laneX = Traffic::laneToX(lane, traffic.getLaneCount());
+        if (laneX - rightX >= CAR_SIZE_X || leftX - laneX >= CAR_SIZE_X) {
+            continue;
+        }
+        // Only cars whose path over the step can reach the player's Y range are tested
+        const std::vector<int>& bucket = broadPhase.getLane(lane);
+        for (size_t pos = broadPhase.lowerBound(traffic, lane, mainY - CAR_SIZE_Y);
+             pos < bucket.size() && traffic.getY(bucket[pos]) < mainY + CAR_SIZE_Y + stepTravel; ++pos) {
+            int i = bucket[pos];
+            float t = playerMask.sweep(stepStartX, endX, mainY, CollisionMask::forSprite(traffic.getSprite(i)),
+                                       traffic.getX(i), traffic.getPreviousY(i), traffic.getY(i));
+            if (t >= 0.0f && (impact < 0.0f || t < impact)) {
+                impact = t;
+            }
+        }
+    }
+    return impact;
+}
+
+// Places a car above the screen in its lane so that there is always a free lane
+void Simulation::respawnCar(int index) {
+    traffic.setY(index, spawnScheduler.place(traffic, broadPhase, index, rng));
+    broadPhase.relocate(traffic, index);
+}
+
+// Advances the simulation by dt milliseconds
+void Simulation::step(qint64 dt, const SimInput& input) {
+    // A crashed run stays frozen until reset()
+    if (crashed) {
+        return;
+    }
+    ++tick;
+
+    // Apply the player's steering before moving traffic; a lane change without
+    // animation happens at the start of the step
+    stepStartX = mainCar.getX();
+    if (input.steer != 0) {
+        int lane = playerLane + (input.steer < 0 ? -1 : 1);
+        if (lane >= 0 && lane < traffic.getLaneCount()) {
+            playerLane = lane;
+            laneChangeFrom = mainCar.getX();
+            laneChangeProgress = 0;
+            if (laneChangeTicks == 0) {
+                mainCar.setX(Traffic::laneToX(playerLane, traffic.getLaneCount()));
+                stepStartX = mainCar.getX();
+            }
+        }
+    }
+
+    // A smooth lane change moves the car part of the way on each tick
+    if (laneChangeProgress < laneChangeTicks) {
+        ++laneChangeProgress;
+        int target = Traffic::laneToX(playerLane, traffic.getLaneCount());
+        mainCar.setX(laneChangeFrom + (target - laneChangeFrom) * laneChangeProgress / laneChangeTicks);
+    }
+
+    // Update level based on elapsed time to increase difficulty
+    level = 3 + 2 * elapsed / 10000;
+
+    // Move the traffic downward; speed is in pixels per second so it does not depend on the tick rate
+    float distance = level * SPEED_PER_LEVEL * (dt / 1000.0f);
+    traffic.advance(distance);
+    broadPhase.restoreOrder(traffic);
+    roadDistance += distance;
+    stepTravel = distance * traffic.getMaxSpeed();
+
+    // Check for collision between the main car and any traffic car, before
+    // cars that passed the bottom edge are moved back above the screen
+    qint64 phaseStart = perfStats ? PerfStats::now() : 0;
+    float impact = checkCollision();
+    if (perfStats) {
+        qint64 collisionEnd = PerfStats::now();
+        perfStats->record(PerfPhase::Collision, collisionEnd - phaseStart);
+        Trace::record("sim", "collision", phaseStart, collisionEnd);
+        phaseStart = collisionEnd;
+    }
+    if (impact >= 0.0f) {
+        crashed = true;
+        mainCar.setSprite(SpriteId::Crashed);
+        finalTime = (elapsed + impact * dt) / 1000.0; // Convert milliseconds to seconds, at the moment of impact
+        LOG_INFO(Simulation, "Collision detected! Final time: %.3f seconds.", finalTime);
+        return;
+    }
+
+    // Cars that left the bottom of the screen re-enter above it in the same
+    // lane; they are always at the end of their lane's bucket
+    wrapped.clear();
+    for (int lane = 0; lane < traffic.getLaneCount(); ++lane) {
+        const std::vector<int>& bucket = broadPhase.getLane(lane);
+        for (int pos = static_cast<int>(bucket.size()) - 1; pos >= 0 && traffic.getY(bucket[pos]) > WINDOWS_SIZE_Y; --pos) {
+            wrapped.push_back(bucket[pos]);
+        }
+    }
+    for (int index : wrapped) {
+        respawnCar(index);
+    }
+    if (perfStats) {
+        qint64 spawnEnd = PerfStats::now();
+        perfStats->record(PerfPhase::Spawn, spawnEnd - phaseStart);
+        Trace::record("sim", "respawn", phaseStart, spawnEnd);
+    }
+
+    elapsed += dt;
+}
+
+// Returns the player's car
+const Car& Simulation::getMainCar() const {
+    return mainCar;
+}
+
+// Returns the traffic cars
+const Traffic& Simulation::getTraffic() const {
+    return traffic;
+}
+
+// Returns the lane the player is driving in
+int Simulation::getPlayerLane() const {
+    return playerLane;
+}
+
+// Returns the current difficulty level (traffic speed)
+int Simulation::getLevel() const {
+    return level;
+}
+
+// Returns the simulated time of the current run in milliseconds
+qint64 Simulation::getElapsed() const {
+    return elapsed;
+}
+
+// Returns how far the road has scrolled in pixels since the run started
+double Simulation::getRoadDistance() const {
+    return roadDistance;
+}
+
+// Returns the seed of the current run
+quint64 Simulation::getSeed() const {
+    return seed;
+}
+
+// Returns the number of steps taken in this run, including the crash step
+quint32 Simulation::getTick() const {
+    return tick;
+}
+
+// Returns true once the player has collided with traffic
+bool Simulation::isCrashed() const {
+    return crashed;
+}
+
+// Returns the survival time of a crashed run in seconds
+double Simulation::getFinalTime() const {
+    return finalTime;
+}
+
+// Copies the complete state into a snapshot
+bool Simulation::save(SimSnapshot& snapshot) const {
+    if (traffic.size() > SNAPSHOT_MAX_TRAFFIC) {
+        return false;
+    }
+    snapshot.seed = seed;
+    snapshot.rngState = rng.getState();
+    snapshot.elapsed = elapsed;
+    snapshot.finalTime = finalTime;
+    snapshot.roadDistance = roadDistance;
+    snapshot.tick = tick;
+    snapshot.laneCount = traffic.getLaneCount();
+    snapshot.trafficCount = traffic.size();
+    snapshot.playerLane = playerLane;
+    snapshot.level = level;
+    snapshot.mainX = mainCar.getX();
+    snapshot.laneChangeTicks = laneChangeTicks;
+    snapshot.laneChangeFrom = laneChangeFrom;
+    snapshot.laneChangeProgress = laneChangeProgress;
+    snapshot.crashed = crashed;
+    snapshot.mainSprite = mainCar.getSprite();
+    snapshot.mainY = mainCar.getY();
+    for (int i = 0; i < traffic.size(); ++i) {
+        snapshot.trafficY[i] = traffic.getY(i);
+        snapshot.trafficPreviousY[i] = traffic.getPreviousY(i);
+    }
+    return true;
+}
+
+// Puts the simulation back into a saved state. Only a snapshot with a
+// different road layout rebuilds the traffic; otherwise the cars are moved
+// in place and the lane buckets only need their order checked.
+void Simulation::restore(const SimSnapshot& snapshot) {
+    if (snapshot.laneCount != traffic.getLaneCount() || snapshot.trafficCount != traffic.size()) {
+        configure(snapshot.laneCount, snapshot.trafficCount);
+    }
+
+    seed = snapshot.seed;
+    rng.setState(snapshot.rngState);
+    elapsed = snapshot.elapsed;
+    finalTime = snapshot.finalTime;
+    roadDistance = snapshot.roadDistance;
+    tick = snapshot.tick;
+    playerLane = snapshot.playerLane;
+    level = snapshot.level;
+    laneChangeTicks = snapshot.laneChangeTicks;
+    laneChangeFrom = snapshot.laneChangeFrom;
+    laneChangeProgress = snapshot.laneChangeProgress;
+    crashed = snapshot.crashed;
+    mainCar.setX(snapshot.mainX);
+    mainCar.setY(snapshot.mainY);
+    stepStartX = snapshot.mainX;
+    stepTravel = 0.0f;
+    mainCar.setSprite(snapshot.mainSprite);
+    for (int i = 0; i < traffic.size(); ++i) {
+        traffic.setY(i, snapshot.trafficY[i], snapshot.trafficPreviousY[i]);
+    }
+    broadPhase.restoreOrder(traffic);
+}
+
+// Sets how many ticks a lane change takes; 0 moves the car instantly
+void Simulation::setLaneChangeTicks(int ticks) {
+    laneChangeTicks = qMax(0, ticks);
+    laneChangeProgress = laneChangeTicks;
+}
+
+// Returns how many ticks a lane change takes
+int Simulation::getLaneChangeTicks() const {
+    return laneChangeTicks;
+}
+
+// Attaches phase timing, which also goes to the trace while tracing is on.
+// The stats object must outlive the simulation or be detached.
+void Simulation::setPerfStats(PerfStats* stats) {
+    perfStats = stats;
+}
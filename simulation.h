@@ -0,0 +1,115 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <QtGlobal>
+#include <type_traits>
+#include <vector>
+#include "shared.h"
+#include "car.h"
+#include "traffic.h"
+#include "broadphase.h"
+#include "spawnscheduler.h"
+#include "rng.h"
+#include "perfstats.h"
+
+#define SIM_STEP_MS 10 // Fixed simulation timestep (100 ticks per second)
+#define SPEED_PER_LEVEL 60 // Traffic speed in pixels per second for each difficulty level
+#define SMOOTH_LANE_CHANGE_TICKS 8 // Duration of a smooth lane change (80 ms)
+
+// Player input applied at the start of a simulation step
+struct SimInput {
+    int steer = 0; // -1 moves one lane left, +1 one lane right, 0 keeps the lane
+};
+
+#define SNAPSHOT_MAX_TRAFFIC 64 // Traffic capacity of a SimSnapshot
+
+// Complete simulation state in a fixed-size, trivially copyable block, so
+// saving or restoring is a flat copy of about 600 bytes whatever the game
+// was doing. Traffic lanes are not stored: car i always drives in lane
+// i % laneCount. Only games with up to SNAPSHOT_MAX_TRAFFIC cars fit.
+struct SimSnapshot {
+    quint64 seed;
+    quint64 rngState;
+    qint64 elapsed;
+    double finalTime;
+    double roadDistance;
+    quint32 tick;
+    qint32 laneCount;
+    qint32 trafficCount;
+    qint32 playerLane;
+    qint32 level;
+    qint32 mainX;
+    qint32 laneChangeTicks;
+    qint32 laneChangeFrom;
+    qint32 laneChangeProgress;
+    bool crashed;
+    SpriteId mainSprite;
+    float mainY;
+    float trafficY[SNAPSHOT_MAX_TRAFFIC];
+    float trafficPreviousY[SNAPSHOT_MAX_TRAFFIC];
+};
+
+static_assert(std::is_trivially_copyable<SimSnapshot>::value, "SimSnapshot must stay a flat copy");
+
+// Widget-free game core: owns the cars, level, elapsed time and collision
+// state. It only depends on QtCore, so it can be stepped headless.
+class Simulation
+{
+public:
+    explicit Simulation(int laneCount = DEFAULT_LANE_COUNT, int trafficCount = DEFAULT_TRAFFIC_COUNT, quint64 seed = 0);
+    void configure(int laneCount, int trafficCount);
+    void reset(); // Restarts with the current seed, so the run repeats exactly
+    void reset(quint64 seed);
+    void step(qint64 dt, const SimInput& input); // dt in milliseconds, normally SIM_STEP_MS
+
+    const Car& getMainCar() const;
+    const Traffic& getTraffic() const;
+    int getPlayerLane() const;
+    int getLevel() const;
+    qint64 getElapsed() const;
+    double getRoadDistance() const;
+    bool isCrashed() const;
+    double getFinalTime() const;
+    quint64 getSeed() const;
+    quint32 getTick() const;
+    float checkCollision() const; // Fraction of the step at the first hit, or -1
+    bool save(SimSnapshot& snapshot) const; // False if the traffic does not fit a snapshot
+    void restore(const SimSnapshot& snapshot);
+    void setLaneChangeTicks(int ticks); // 0 teleports between lanes
+    int getLaneChangeTicks() const;
+    void setPerfStats(PerfStats* stats); // Times, and traces, the spawn and collision phases of each step; nullptr disables
+
+private:
+    Car mainCar;
+    int playerLane; // Lane the player is in or moving to
+    int laneChangeTicks; // Ticks a lane change takes; collisions use the car's X on the way
+    int laneChangeFrom; // X where the current lane change started
+    int laneChangeProgress; // Ticks done of the current lane change
+    Traffic traffic;
+    BroadPhase broadPhase; // Per-lane buckets of traffic sorted by Y
+    SpawnScheduler spawnScheduler;
+    Rng rng;
+    quint64 seed;
+    int trafficCount;
+    int level;
+    bool crashed;
+    double finalTime; // Seconds survived, up to the moment of impact within the crash step
+
+    // Sweep of the current step for the collision test
+    int stepStartX; // Player X at the start of the step, after an instant lane change
+    float stepTravel; // Farthest any car moved in the step
+
+    // Timing
+    qint64 elapsed; // Elapsed simulated time in milliseconds
+    quint32 tick; // Number of steps taken in this run
+    double roadDistance; // Distance the road has scrolled in pixels, drives the background animation
+
+    std::vector<int> wrapped; // Scratch list of cars that left the screen this step
+    PerfStats* perfStats; // Optional phase timings, not owned
+
+    // Methods
+    void initializeCarPositions();
+    void respawnCar(int index);
+};
+
+#endif // SIMULATION_H
@@ -0,0 +1,56 @@
+#include "spawnscheduler.h"
+#include <algorithm>
+
+// ===========================
+// SpawnScheduler Class Implementation
+// ===========================
+
+// Constructor sets the wall band from the car size and padding
+SpawnScheduler::SpawnScheduler() : band(2 * CAR_SIZE_Y + SPAWN_PADDING + SPAWN_MARGIN) {}
+
+// Returns true if a lane has a car other than exclude strictly within the band around y
+bool SpawnScheduler::laneHasCarNear(const Traffic &traffic, const BroadPhase &broadPhase,
+                                    int lane, int exclude, float y) const {
+    const std::vector<int>& bucket = broadPhase.getLane(lane);
+    for (size_t pos = broadPhase.lowerBound(traffic, lane, y - band);
+         pos < bucket.size() && traffic.getY(bucket[pos]) < y + band; ++pos) {
+        if (bucket[pos] != exclude && traffic.getY(bucket[pos]) > y - band) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns a Y above the screen for the car at index that keeps a free lane
+float SpawnScheduler::place(const Traffic &traffic, const BroadPhase &broadPhase, int index, Rng &rng) const {
+    const int lane = traffic.getLane(index);
+    const int laneCount = traffic.getLaneCount();
+
+    // Above the screen and above the other cars in the lane, with random spacing
+    float y = -CAR_SIZE_Y;
+    int laneTop = broadPhase.laneTop(lane, index);
+    if (laneTop >= 0) {
+        y = std::min(y, traffic.getY(laneTop) - LANE_MIN_GAP);
+    }
+    y -= rng.bounded(SPAWN_JITTER);
+
+    if (laneCount < 2) {
+        return y;
+    }
+
+    // Keep y if some other lane is free around it; otherwise every other lane's
+    // top car is within the band, and the lowest of them bounds the fix
+    float lowestTop = -1e30f;
+    for (int other = 0; other < laneCount; ++other) {
+        if (other == lane) {
+            continue;
+        }
+        if (!laneHasCarNear(traffic, broadPhase, other, index, y)) {
+            return y;
+        }
+        lowestTop = std::max(lowestTop, traffic.getY(broadPhase.laneTop(other, index)));
+    }
+
+    // Every car of that lane is at or below its top, so the lane is free around the new Y
+    return lowestTop - band;
+}
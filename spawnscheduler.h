@@ -0,0 +1,32 @@
+#ifndef SPAWNSCHEDULER_H
+#define SPAWNSCHEDULER_H
+
+#include "traffic.h"
+#include "broadphase.h"
+#include "rng.h"
+
+#define LANE_MIN_GAP (CAR_SIZE_Y + 100) // Minimum distance between consecutive cars in one lane
+#define SPAWN_JITTER 800 // Random extra distance above the spawn point
+#define SPAWN_PADDING 350 // Extra spacing on top of two car lengths when checking for walls
+#define SPAWN_MARGIN 4 // Slack for float rounding as cars move, so a free lane stays free
+
+// Chooses where a car re-enters the road. The position is built so that it
+// is valid without retries: no window of height 2 * CAR_SIZE_Y + SPAWN_PADDING
+// may hold a car in every lane. The car goes above the other cars in its
+// lane; if some other lane has no car within one band of that spot, no window
+// through it can be full. Otherwise it is lifted one band above the lowest of
+// the other lanes' top cars, which leaves that lane free around it.
+// The work per spawn is one nearest-car lookup per lane.
+class SpawnScheduler
+{
+public:
+    SpawnScheduler();
+    float place(const Traffic& traffic, const BroadPhase& broadPhase, int index, Rng& rng) const;
+
+private:
+    float band; // Wall band plus SPAWN_MARGIN
+
+    bool laneHasCarNear(const Traffic& traffic, const BroadPhase& broadPhase, int lane, int exclude, float y) const;
+};
+
+#endif // SPAWNSCHEDULER_H
@@ -0,0 +1,314 @@
+#include "spriteblitter.h"
+#include <QPainter>
+#include <QString>
+#include <cstring>
+
+// SSE2 is part of every x86-64 target. AVX2 is compiled per function with the
+// GCC/Clang target attribute and only used if the CPU reports it at runtime.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SPRITEBLITTER_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__)
+#define SPRITEBLITTER_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+// ===========================
+// SpriteBlitter Implementation
+// ===========================
+
+namespace {
+
+// Blends one premultiplied pixel over another: src + dst * (255 - srcAlpha) / 255.
+// The division rounds like the SIMD kernels, so every path gives the same bytes.
+inline quint32 blendPixel(quint32 src, quint32 dst) {
+    const quint32 inverseAlpha = 255 - (src >> 24);
+    quint32 result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        quint32 t = ((dst >> shift) & 0xFF) * inverseAlpha + 128;
+        t = ((t + (t >> 8)) >> 8) + ((src >> shift) & 0xFF);
+        result |= qMin<quint32>(t, 255) << shift;
+    }
+    return result;
+}
+
+// Blends a row one pixel at a time; opaque pixels are copied, empty ones skipped
+void blendRowScalar(quint32* dst, const quint32* src, int count) {
+    for (int i = 0; i < count; ++i) {
+        const quint32 s = src[i];
+        if (s >= 0xFF000000u) {
+            dst[i] = s;
+        } else if (s != 0) {
+            dst[i] = blendPixel(s, dst[i]);
+        }
+    }
+}
+
+// Blends one color over a row
+void blendColorScalar(quint32* dst, quint32 color, int count) {
+    for (int i = 0; i < count; ++i) {
+        dst[i] = blendPixel(color, dst[i]);
+    }
+}
+
+#ifdef SPRITEBLITTER_SSE2
+// Divides eight 16-bit products by 255 with the same rounding as blendPixel
+inline __m128i divideBy255(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// Blends one color over a row four pixels at a time
+void blendColorSse2(quint32* dst, quint32 color, int count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i s = _mm_set1_epi32(static_cast<int>(color));
+    const __m128i inverse = _mm_set1_epi16(static_cast<short>(255 - (color >> 24)));
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i low = divideBy255(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inverse));
+        const __m128i high = divideBy255(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inverse));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_adds_epu8(_mm_packus_epi16(low, high), s));
+    }
+    blendColorScalar(dst + i, color, count - i);
+}
+
+// Blends a row four pixels at a time; groups that are all opaque or all empty
+// (most of a car sprite) skip the arithmetic
+void blendRowSse2(quint32* dst, const quint32* src, int count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m128i full = _mm_set1_epi32(255);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, alphaMask), alphaMask)) == 0xFFFF) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), s);
+            continue;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(s, zero)) == 0xFFFF) {
+            continue;
+        }
+
+        // Spread 255 - alpha of each pixel over its four 16-bit channel lanes
+        __m128i inverse = _mm_sub_epi32(full, _mm_srli_epi32(s, 24));
+        inverse = _mm_or_si128(inverse, _mm_slli_epi32(inverse, 16));
+        const __m128i inverseLow = _mm_unpacklo_epi32(inverse, inverse);
+        const __m128i inverseHigh = _mm_unpackhi_epi32(inverse, inverse);
+
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i low = divideBy255(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inverseLow));
+        const __m128i high = divideBy255(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inverseHigh));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_adds_epu8(_mm_packus_epi16(low, high), s));
+    }
+    blendRowScalar(dst + i, src + i, count - i);
+}
+#endif
+
+#ifdef SPRITEBLITTER_AVX2
+// Divides sixteen 16-bit products by 255 with the same rounding as blendPixel
+__attribute__((target("avx2"))) inline __m256i divideBy255Avx2(__m256i x) {
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+// Blends a row eight pixels at a time. Unpack and pack work within each
+// 128-bit half, so pixel order is preserved without extra permutes.
+__attribute__((target("avx2"))) void blendRowAvx2(quint32* dst, const quint32* src, int count) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m256i full = _mm256_set1_epi32(255);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(s, alphaMask), alphaMask)) == -1) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), s);
+            continue;
+        }
+        if (_mm256_testz_si256(s, s)) {
+            continue;
+        }
+
+        __m256i inverse = _mm256_sub_epi32(full, _mm256_srli_epi32(s, 24));
+        inverse = _mm256_or_si256(inverse, _mm256_slli_epi32(inverse, 16));
+        const __m256i inverseLow = _mm256_unpacklo_epi32(inverse, inverse);
+        const __m256i inverseHigh = _mm256_unpackhi_epi32(inverse, inverse);
+
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i low = divideBy255Avx2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), inverseLow));
+        const __m256i high = divideBy255Avx2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), inverseHigh));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_adds_epu8(_mm256_packus_epi16(low, high), s));
+    }
+
+    // Clear the upper halves before legacy SSE code runs the tail, or every
+    // SSE instruction there pays an AVX/SSE transition penalty
+    _mm256_zeroupper();
+    blendRowSse2(dst + i, src + i, count - i);
+}
+#endif
+
+typedef void (*BlendRow)(quint32* dst, const quint32* src, int count);
+
+// Returns the row kernel for a software path, or nullptr if it is not available
+BlendRow rowKernel(BlitPath path) {
+    if (!SpriteBlitter::isSupported(path)) {
+        return nullptr;
+    }
+    switch (path) {
+    case BlitPath::Scalar: return blendRowScalar;
+#ifdef SPRITEBLITTER_SSE2
+    case BlitPath::Sse2: return blendRowSse2;
+#endif
+#ifdef SPRITEBLITTER_AVX2
+    case BlitPath::Avx2: return blendRowAvx2;
+#endif
+    default: return nullptr;
+    }
+}
+
+// Returns true for the formats the software kernels read and write
+bool isBlendable(const QImage& image) {
+    return image.format() == QImage::Format_ARGB32_Premultiplied || image.format() == QImage::Format_RGB32;
+}
+
+} // namespace
+
+// Returns true if the path was compiled in and the CPU can run it
+bool SpriteBlitter::isSupported(BlitPath path) {
+    switch (path) {
+    case BlitPath::Painter:
+    case BlitPath::Scalar:
+        return true;
+    case BlitPath::Sse2:
+#ifdef SPRITEBLITTER_SSE2
+        return true;
+#else
+        return false;
+#endif
+    case BlitPath::Avx2:
+#ifdef SPRITEBLITTER_AVX2
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+// Returns the fastest software path this CPU supports
+BlitPath SpriteBlitter::bestPath() {
+    if (isSupported(BlitPath::Avx2)) {
+        return BlitPath::Avx2;
+    }
+    if (isSupported(BlitPath::Sse2)) {
+        return BlitPath::Sse2;
+    }
+    return BlitPath::Scalar;
+}
+
+// Parses painter, scalar, sse2, avx2 or auto (the best supported path)
+BlitPath SpriteBlitter::fromName(const QString& name, bool* ok) {
+    if (ok) {
+        *ok = true;
+    }
+    for (BlitPath path : {BlitPath::Painter, BlitPath::Scalar, BlitPath::Sse2, BlitPath::Avx2}) {
+        if (name.compare(QLatin1String(SpriteBlitter::name(path)), Qt::CaseInsensitive) == 0) {
+            return path;
+        }
+    }
+    if (name.compare(QLatin1String("auto"), Qt::CaseInsensitive) != 0 && ok) {
+        *ok = false;
+    }
+    return bestPath();
+}
+
+// Returns the command-line name of a path
+const char* SpriteBlitter::name(BlitPath path) {
+    switch (path) {
+    case BlitPath::Painter: return "painter";
+    case BlitPath::Scalar: return "scalar";
+    case BlitPath::Sse2: return "sse2";
+    case BlitPath::Avx2: return "avx2";
+    }
+    return "unknown";
+}
+
+// Copies an opaque frame (the background) into the top left of the target row by row
+void SpriteBlitter::copy(QImage& target, const QImage& source) {
+    if (!isBlendable(target) || !isBlendable(source)) {
+        QPainter painter(&target);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.drawImage(0, 0, source);
+        return;
+    }
+
+    const int width = qMin(target.width(), source.width());
+    const int height = qMin(target.height(), source.height());
+    for (int y = 0; y < height; ++y) {
+        std::memcpy(target.scanLine(y), source.constScanLine(y), size_t(width) * sizeof(quint32));
+    }
+}
+
+// Blends a sprite over the target at a device pixel position, clipped to the target
+void SpriteBlitter::blend(QImage& target, const QImage& sprite, QPoint position, BlitPath path) {
+    BlendRow kernel = rowKernel(path);
+    if (!kernel || !isBlendable(target) || !isBlendable(sprite)) {
+        // Painter path, or an image the kernels cannot read
+        QPainter painter(&target);
+        painter.scale(1.0 / target.devicePixelRatio(), 1.0 / target.devicePixelRatio());
+        painter.drawImage(QRect(position, sprite.size()), sprite);
+        return;
+    }
+
+    // Clip the sprite rectangle against the target
+    const int left = qMax(0, position.x());
+    const int top = qMax(0, position.y());
+    const int right = qMin(target.width(), position.x() + sprite.width());
+    const int bottom = qMin(target.height(), position.y() + sprite.height());
+    if (left >= right || top >= bottom) {
+        return;
+    }
+
+    const int width = right - left;
+    const int spriteX = left - position.x();
+    for (int y = top; y < bottom; ++y) {
+        quint32* dst = reinterpret_cast<quint32*>(target.scanLine(y)) + left;
+        const quint32* src = reinterpret_cast<const quint32*>(sprite.constScanLine(y - position.y())) + spriteX;
+        kernel(dst, src, width);
+    }
+}
+
+// Blends one premultiplied color over a device pixel rect, clipped to the
+// target. Used for particles; the SSE2 kernel gives the same bytes as the
+// scalar one, so it is used whenever it is compiled in.
+void SpriteBlitter::blendRect(QImage& target, const QRect& rect, quint32 color) {
+    if (!isBlendable(target)) {
+        QPainter painter(&target);
+        painter.scale(1.0 / target.devicePixelRatio(), 1.0 / target.devicePixelRatio());
+        painter.fillRect(rect, QColor::fromRgba(qUnpremultiply(color)));
+        return;
+    }
+
+    const int left = qMax(0, rect.left());
+    const int top = qMax(0, rect.top());
+    const int right = qMin(target.width(), rect.right() + 1);
+    const int bottom = qMin(target.height(), rect.bottom() + 1);
+    if (left >= right || top >= bottom || color == 0) {
+        return;
+    }
+
+    const int width = right - left;
+    for (int y = top; y < bottom; ++y) {
+        quint32* dst = reinterpret_cast<quint32*>(target.scanLine(y)) + left;
+#ifdef SPRITEBLITTER_SSE2
+        blendColorSse2(dst, color, width);
+#else
+        blendColorScalar(dst, color, width);
+#endif
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef SPRITEBLITTER_H
+#define SPRITEBLITTER_H
+
+#include <QImage>
+#include <QPoint>
+#include <QRect>
+
+// How the frame composer draws sprites. Painter uses QPainter::drawImage;
+// the others blend premultiplied ARGB32 pixels straight into the frame
+// with a scalar, SSE2 (4 pixels) or AVX2 (8 pixels) kernel. All software
+// kernels produce bit-identical results.
+enum class BlitPath : unsigned char {
+    Painter,
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+// Software raster blits for the frame composer. Both images must be
+// Format_ARGB32_Premultiplied (RGB32 is accepted as an opaque source) and
+// positions are in device pixels. Sprites partly outside the target, e.g.
+// traffic entering from above with a negative Y, are clipped.
+namespace SpriteBlitter {
+bool isSupported(BlitPath path);
+BlitPath bestPath();
+BlitPath fromName(const QString& name, bool* ok = nullptr);
+const char* name(BlitPath path);
+void copy(QImage& target, const QImage& source);
+void blend(QImage& target, const QImage& sprite, QPoint position, BlitPath path);
+void blendRect(QImage& target, const QRect& rect, quint32 color); // color is premultiplied ARGB
+}
+
+#endif // SPRITEBLITTER_H
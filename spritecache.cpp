@@ -0,0 +1,162 @@
+#include "spritecache.h"
+#include <QDebug>
+#include <QThreadPool>
+#include "gamelog.h"
+#include "trace.h"
+
+// ===========================
+// SpriteCache Class Implementation
+// ===========================
+
+// Compares two cache keys
+bool SpriteCache::Key::operator==(const Key &other) const {
+    return path == other.path && size == other.size && qFuzzyCompare(devicePixelRatio, other.devicePixelRatio);
+}
+
+// Hashes a cache key for QHash
+size_t qHash(const SpriteCache::Key &key, size_t seed) {
+    return qHashMulti(seed, key.path, key.size.width(), key.size.height(), qRound(key.devicePixelRatio * 100));
+}
+
+// Constructor leaves every sprite id null until preload()
+SpriteCache::SpriteCache() : pendingLoads(0) {}
+
+// Returns the process-wide cache
+SpriteCache& SpriteCache::instance() {
+    static SpriteCache cache;
+    return cache;
+}
+
+// Returns the resource an id is drawn from
+QString SpriteCache::resourcePath(SpriteId id) {
+    switch (id) {
+    case SpriteId::Player: return ":/img/car_image.png";
+    case SpriteId::Traffic: return ":/img/secondary_car2.png";
+    case SpriteId::Crashed: return ":/img/crashed_car.png";
+    default: return QString();
+    }
+}
+
+// Returns true if a sprite can be on screen in the first frame of a run
+bool SpriteCache::isNeededForFirstFrame(SpriteId id) {
+    return id != SpriteId::Crashed;
+}
+
+// Returns the sprites baked into the binary, by resource path. A function
+// static, so registration from other translation units before main() is safe.
+QHash<QString, QVector<SpriteCache::BakedSprite>>& SpriteCache::bakedSprites() {
+    static QHash<QString, QVector<BakedSprite>> sprites;
+    return sprites;
+}
+
+// Called by the generated sources of the asset bake step before main().
+// pixels must stay valid for the life of the process.
+bool SpriteCache::registerBaked(const char* path, int boxWidth, int boxHeight, int width, int height,
+                                const uchar* pixels) {
+    bakedSprites()[QString::fromLatin1(path)].append(
+        BakedSprite{QSize(boxWidth, boxHeight), QSize(width, height), pixels});
+    return true;
+}
+
+// Returns a sprite scaled to fit size at the given device pixel ratio. Uses
+// the baked pixels without copying them if the build made this size, and
+// decodes and scales the resource otherwise. Safe to call from any thread.
+QImage SpriteCache::loadImage(const QString& path, const QSize& size, qreal devicePixelRatio) {
+    TRACE_SCOPE("assets", "load sprite");
+    const QSize box = size * devicePixelRatio;
+    QImage image;
+    for (const BakedSprite& baked : bakedSprites().value(path)) {
+        if (baked.box == box) {
+            image = QImage(baked.pixels, baked.size.width(), baked.size.height(), baked.size.width() * 4,
+                           QImage::Format_ARGB32_Premultiplied);
+            break;
+        }
+    }
+
+    if (image.isNull()) {
+        if (!image.load(path)) {
+            qWarning() << "Failed to load image from" << path;
+            return image;
+        }
+        // Same conversion and scaling as the bake step, so both give the same pixels
+        image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied)
+                    .scaled(box, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        LOG_INFO(Game, "Loaded and scaled sprite to size (%.0f, %.0f)", size.width(), size.height());
+    }
+    image.setDevicePixelRatio(devicePixelRatio);
+    return image;
+}
+
+// Resolves every car sprite for the given device pixel ratio. Baked sprites
+// and the ones the first frame shows are ready on return; the others are
+// decoded on the thread pool.
+void SpriteCache::preload(qreal devicePixelRatio) {
+    takeFinished(true);
+    const QSize size(CAR_SIZE_X, CAR_SIZE_Y);
+    for (int i = 0; i < static_cast<int>(SpriteId::Count); ++i) {
+        SpriteId id = static_cast<SpriteId>(i);
+        QString path = resourcePath(id);
+        if (isNeededForFirstFrame(id) || bakedSprites().contains(path)) {
+            byId[i] = get(path, size, devicePixelRatio);
+            continue;
+        }
+
+        byId[i] = QPixmap();
+        {
+            QMutexLocker locker(&mutex);
+            ++pendingLoads;
+        }
+        QThreadPool::globalInstance()->start([this, id, path, size, devicePixelRatio]() {
+            Trace::setThreadName("sprite loader");
+            QImage image = loadImage(path, size, devicePixelRatio);
+            QMutexLocker locker(&mutex);
+            finished.append(qMakePair(id, image));
+            --pendingLoads;
+            loaded.wakeAll();
+        });
+    }
+}
+
+// Takes over the sprites the thread pool has finished; never waits
+void SpriteCache::collectLoaded() const {
+    takeFinished(false);
+}
+
+// Turns finished background decodes into pixmaps on the GUI thread,
+// optionally waiting for the ones still running
+void SpriteCache::takeFinished(bool wait) const {
+    QVector<QPair<SpriteId, QImage>> images;
+    {
+        QMutexLocker locker(&mutex);
+        while (wait && pendingLoads > 0) {
+            loaded.wait(&mutex);
+        }
+        images.swap(finished);
+    }
+    for (const QPair<SpriteId, QImage>& entry : images) {
+        byId[static_cast<int>(entry.first)] = QPixmap::fromImage(entry.second);
+    }
+}
+
+// Returns the cached sprite, loading and scaling it on the first request
+QPixmap SpriteCache::get(const QString &path, const QSize &size, qreal devicePixelRatio) {
+    Key key{path, size, devicePixelRatio};
+    auto it = entries.constFind(key);
+    if (it != entries.constEnd()) {
+        return *it;
+    }
+
+    QPixmap image = QPixmap::fromImage(loadImage(path, size, devicePixelRatio));
+    entries.insert(key, image);
+    return image;
+}
+
+// Returns the preloaded pixmap for a sprite id, waiting for it if it is
+// still being decoded in the background
+const QPixmap& SpriteCache::pixmap(SpriteId id) const {
+    const QPixmap& sprite = byId[static_cast<int>(id)];
+    if (sprite.isNull()) {
+        takeFinished(true);
+    }
+    return sprite;
+}
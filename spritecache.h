@@ -0,0 +1,70 @@
+#ifndef SPRITECACHE_H
+#define SPRITECACHE_H
+
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+#include <QVector>
+#include <QWaitCondition>
+#include "car.h"
+
+// Process-wide cache of decoded and scaled sprites, keyed by resource path,
+// target size and device pixel ratio. Every SpriteId is resolved once in
+// preload(); afterwards pixmap() is an array lookup, so swapping a car's
+// sprite never decodes or rescales an image during gameplay.
+// Sprites pre-scaled at build time (see assets.pri) are registered before
+// main() and used as is. Others are decoded at startup; those the first
+// frame does not show are decoded on the thread pool and taken over by
+// collectLoaded(), or by pixmap() if they are needed earlier.
+class SpriteCache
+{
+public:
+    static SpriteCache& instance();
+
+    void preload(qreal devicePixelRatio);
+    void collectLoaded() const;
+    QPixmap get(const QString& path, const QSize& size, qreal devicePixelRatio);
+    const QPixmap& pixmap(SpriteId id) const;
+    static QString resourcePath(SpriteId id);
+    static bool isNeededForFirstFrame(SpriteId id);
+    static QImage loadImage(const QString& path, const QSize& size, qreal devicePixelRatio);
+    static bool registerBaked(const char* path, int boxWidth, int boxHeight, int width, int height,
+                              const uchar* pixels);
+
+private:
+    SpriteCache();
+    SpriteCache(const SpriteCache&) = delete;
+    SpriteCache& operator=(const SpriteCache&) = delete;
+
+    struct Key {
+        QString path;
+        QSize size;
+        qreal devicePixelRatio;
+        bool operator==(const Key& other) const;
+    };
+    friend size_t qHash(const Key& key, size_t seed);
+
+    // A sprite scaled to fit a box at build time, as premultiplied ARGB32 pixels
+    struct BakedSprite {
+        QSize box;
+        QSize size;
+        const uchar* pixels;
+    };
+    static QHash<QString, QVector<BakedSprite>>& bakedSprites();
+
+    void takeFinished(bool wait) const;
+
+    QHash<Key, QPixmap> entries;
+    mutable QPixmap byId[static_cast<int>(SpriteId::Count)]; // Shared copies of the entries, indexed by SpriteId
+
+    // Sprites decoded on the thread pool, guarded by mutex
+    mutable QMutex mutex;
+    mutable QWaitCondition loaded;
+    mutable QVector<QPair<SpriteId, QImage>> finished;
+    mutable int pendingLoads;
+};
+
+#endif // SPRITECACHE_H
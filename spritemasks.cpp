@@ -0,0 +1,615 @@
+// Generated by assetbake --masks from car_image.png, secondary_car2.png, crashed_car.png; do not edit.
+
+#include "collisionmask.h"
+
+const CollisionMask CollisionMask::bySprite[static_cast<int>(SpriteId::Count)] = {
+    // SpriteId::Player, car_image.png scaled to 100x188
+    { 6, 7, 94, 177, {
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x1fffff8000000000ull, 0x0000000000000000ull },
+        { 0xfffffffe00000000ull, 0x0000000000000007ull },
+        { 0xffffffffc0000000ull, 0x000000000000003full },
+        { 0xfffffffff8000000ull, 0x00000000000001ffull },
+        { 0xffffffffff000000ull, 0x0000000000000fffull },
+        { 0xffffffffffc00000ull, 0x0000000000001fffull },
+        { 0xfffffffff3e00000ull, 0x0000000000007c7full },
+        { 0xfffffffff0780000ull, 0x000000000000f0ffull },
+        { 0xfffffffff83c0000ull, 0x000000000003e0ffull },
+        { 0xfffffffffc1e0000ull, 0x00000000000781ffull },
+        { 0xfffffffffe0f0000ull, 0x00000000000f03ffull },
+        { 0xffffffffff078000ull, 0x00000000000e07ffull },
+        { 0xffffffffff838000ull, 0x00000000001e0fffull },
+        { 0xffffffffffc18000ull, 0x00000000001c1fffull },
+        { 0xffffffffffc1c000ull, 0x0000000000183fffull },
+        { 0xffffffffffe0c000ull, 0x0000000000383fffull },
+        { 0xffffffffffe0c000ull, 0x0000000000303fffull },
+        { 0xffffffffffe04000ull, 0x0000000000303fffull },
+        { 0xffffffffffe06000ull, 0x0000000000303fffull },
+        { 0xffffffffffe06000ull, 0x0000000000703fffull },
+        { 0xffffffffffe06000ull, 0x0000000000607fffull },
+        { 0xffffffffffe06000ull, 0x0000000000607fffull },
+        { 0xfffffffffff07000ull, 0x0000000000707fffull },
+        { 0xfffffffffff8f000ull, 0x000000000070ffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffffc00ull, 0x0000000001ffffffull },
+        { 0xfffffffffffffc00ull, 0x0000000001ffffffull },
+        { 0xfffffffffffffc00ull, 0x0000000001ffffffull },
+        { 0xfffffffffffffc00ull, 0x0000000001ffffffull },
+        { 0xfffffffffffffc00ull, 0x0000000001ffffffull },
+        { 0xfffffffffffffc00ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffffe00ull, 0x0000000003ffffffull },
+        { 0xffffffffffffff00ull, 0x0000000007ffffffull },
+        { 0xffffffffffffff00ull, 0x000000000fffffffull },
+        { 0xffffffffffffff80ull, 0x000000001fffffffull },
+        { 0xffffffffffffffc0ull, 0x000000001fffffffull },
+        { 0xffffffffffffffc0ull, 0x000000003fffffffull },
+        { 0xfffffffffffff080ull, 0x00000000107fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffffc00ull, 0x0000000001ffffffull },
+        { 0xfffffffffffffc00ull, 0x0000000001ffffffull },
+        { 0xfffffffffffffc00ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x00000000007fffffull },
+        { 0xffffffffffffe000ull, 0x00000000007fffffull },
+        { 0xffffffffffffe000ull, 0x00000000003fffffull },
+        { 0xffffffffffffc000ull, 0x00000000001fffffull },
+        { 0xffffffffffff8000ull, 0x00000000001fffffull },
+        { 0xffffffffffff8000ull, 0x00000000000fffffull },
+        { 0xffffffffffff8000ull, 0x00000000000fffffull },
+        { 0xffffffffffff8000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000003ffffull },
+        { 0xfffffffffffc0000ull, 0x000000000003ffffull },
+        { 0xfffffffffff80000ull, 0x000000000001ffffull },
+        { 0xfffffffffff00000ull, 0x000000000000ffffull },
+        { 0xffffffffffe00000ull, 0x0000000000003fffull },
+        { 0xffffffffff800000ull, 0x0000000000001fffull },
+        { 0xfffffffffe000000ull, 0x00000000000003ffull },
+        { 0xffffffffe0000000ull, 0x000000000000003full },
+        { 0x71ff80e000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+    } },
+    // SpriteId::Traffic, secondary_car2.png scaled to 100x190
+    { 11, 10, 89, 180, {
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0xfffffff000000000ull, 0x0000000000000000ull },
+        { 0xffffffff80000000ull, 0x000000000000001full },
+        { 0xffffffffe0000000ull, 0x000000000000007full },
+        { 0xfffffffffc000000ull, 0x00000000000003ffull },
+        { 0xfffffffffe000000ull, 0x00000000000007ffull },
+        { 0xffffffffff800000ull, 0x0000000000001fffull },
+        { 0xffffffffffc00000ull, 0x0000000000003fffull },
+        { 0xffffffffffe00000ull, 0x0000000000007fffull },
+        { 0xfffffffffff00000ull, 0x000000000000ffffull },
+        { 0xfffffffffff80000ull, 0x000000000000ffffull },
+        { 0xfffffffffff80000ull, 0x000000000001ffffull },
+        { 0xfffffffffffc0000ull, 0x000000000001ffffull },
+        { 0xfffffffffffc0000ull, 0x000000000003ffffull },
+        { 0xfffffffffffc0000ull, 0x000000000003ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xffffffffffff0000ull, 0x000000000007ffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xffffffffffff8000ull, 0x00000000001fffffull },
+        { 0xffffffffffffe000ull, 0x00000000007fffffull },
+        { 0xfffffffffffff000ull, 0x0000000000ffffffull },
+        { 0xfffffffffffff800ull, 0x0000000001ffffffull },
+        { 0xfffffffffffe7800ull, 0x0000000001c7ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x00000000000fffffull },
+        { 0xfffffffffffe0000ull, 0x00000000000fffffull },
+        { 0xfffffffffffe0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xfffffffffffe0000ull, 0x00000000000fffffull },
+        { 0xfffffffffffe0000ull, 0x00000000000fffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x00000000000fffffull },
+        { 0xfffffffffffe0000ull, 0x00000000000fffffull },
+        { 0xfffffffffffe0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000001fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xffffffffffff0000ull, 0x00000000000fffffull },
+        { 0xfffffffffffe0000ull, 0x00000000000fffffull },
+        { 0xfffffffffffe0000ull, 0x00000000000fffffull },
+        { 0xfffffffffffe0000ull, 0x00000000000fffffull },
+        { 0xfffffffffffe0000ull, 0x00000000000fffffull },
+        { 0xfffffffffffe0000ull, 0x00000000000fffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffc0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffc0000ull, 0x000000000007ffffull },
+        { 0xfffffffffffc0000ull, 0x000000000003ffffull },
+        { 0xfffffffffff80000ull, 0x000000000003ffffull },
+        { 0xfffffffffff80000ull, 0x000000000001ffffull },
+        { 0xfffffffffff00000ull, 0x000000000001ffffull },
+        { 0xffffffffffe00000ull, 0x000000000000ffffull },
+        { 0xffffffffffc00000ull, 0x0000000000003fffull },
+        { 0xffffffffff000000ull, 0x0000000000000fffull },
+        { 0xfffffffffc000000ull, 0x00000000000007ffull },
+        { 0xfffffffff8000000ull, 0x00000000000003ffull },
+        { 0xfffffffff0000000ull, 0x00000000000000ffull },
+        { 0x1fffff8000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+    } },
+    // SpriteId::Crashed, crashed_car.png scaled to 94x200
+    { 1, 4, 94, 192, {
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000008000ull, 0x0000000000000000ull },
+        { 0x0000000000003000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x018fc07fffe00000ull, 0x0000000000000000ull },
+        { 0x03fffffffffc0000ull, 0x0000000000000000ull },
+        { 0x07ffffffffff0000ull, 0x0000000000000000ull },
+        { 0x7fffffffffffc000ull, 0x0000000000000000ull },
+        { 0xffffffffffffe000ull, 0x0000000000000000ull },
+        { 0xfffffffffcffe000ull, 0x0000000000000001ull },
+        { 0xfffffffffc3ff000ull, 0x000000000000000full },
+        { 0xfffffffffe0ff800ull, 0x000000000000003full },
+        { 0xfffffffffe07f800ull, 0x000000000000007full },
+        { 0xfffffffffe03fc00ull, 0x00000000000000ffull },
+        { 0xffffffffff01fc00ull, 0x00000000000000ffull },
+        { 0xffffffffff00fe00ull, 0x00000000000001ffull },
+        { 0xffffffffff807e00ull, 0x00000000000007ffull },
+        { 0xffffffffffc07f00ull, 0x0000000000000fffull },
+        { 0xffffffffffc03f00ull, 0x0000000000003fffull },
+        { 0xffffffffffe03f80ull, 0x000000000000ffffull },
+        { 0xffffffffffe01f80ull, 0x000000000000ffffull },
+        { 0xfffffffffff01fc0ull, 0x000000000003ffffull },
+        { 0xfffffffffff80fc0ull, 0x000000000007ffffull },
+        { 0xfffffffffff80fc0ull, 0x00000000000fffffull },
+        { 0xfffffffffffc0fe0ull, 0x00000000001fffffull },
+        { 0xfffffffffffe0fe0ull, 0x00000000003fffffull },
+        { 0xffffffffffff0fe0ull, 0x00000000003fffffull },
+        { 0xffffffffffff9e00ull, 0x00000000007fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000007fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000007fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000007fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000007fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000007fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000003fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000003fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000003fffffull },
+        { 0xffffffffffffff00ull, 0x00000000003fffffull },
+        { 0xffffffffffffffc0ull, 0x00000000007fffffull },
+        { 0xfffffffffffffff0ull, 0x00000000007fffffull },
+        { 0xfffffffffffffffcull, 0x00000000007fffffull },
+        { 0xfffffffffffffffeull, 0x00000000007fffffull },
+        { 0xfffffffffffffffeull, 0x00000000007fffffull },
+        { 0xfffffffffffffffeull, 0x00000000007fffffull },
+        { 0xfffffffffffffffeull, 0x00000000007fffffull },
+        { 0xfffffffffffffffcull, 0x00000000007fffffull },
+        { 0xfffffffffffffffcull, 0x00000000007fffffull },
+        { 0xfffffffffffffffcull, 0x00000000007fffffull },
+        { 0xfffffffffffffff8ull, 0x00000000007fffffull },
+        { 0xfffffffffffffff8ull, 0x00000000007fffffull },
+        { 0xfffffffffffffff0ull, 0x00000000007fffffull },
+        { 0xfffffffffffffff0ull, 0x00000000007fffffull },
+        { 0xffffffffffffffe0ull, 0x00000000007fffffull },
+        { 0xffffffffffffffe0ull, 0x00000000007fffffull },
+        { 0xffffffffffffffc0ull, 0x0000000000ffffffull },
+        { 0xffffffffffffffc0ull, 0x0000000000ffffffull },
+        { 0xffffffffffffffc0ull, 0x0000000001ffffffull },
+        { 0xffffffffffffff80ull, 0x0000000001ffffffull },
+        { 0xffffffffffffff80ull, 0x0000000003ffffffull },
+        { 0xffffffffffffff80ull, 0x0000000007ffffffull },
+        { 0xffffffffffffff80ull, 0x0000000007ffffffull },
+        { 0xffffffffffffff00ull, 0x000000000fffffffull },
+        { 0xffffffffffffff00ull, 0x000000001fffffffull },
+        { 0xffffffffffffff00ull, 0x000000001fffffffull },
+        { 0xffffffffffffff00ull, 0x000000003fffffffull },
+        { 0xffffffffffffff00ull, 0x000000003fffffffull },
+        { 0xffffffffffffff80ull, 0x000000001fffffffull },
+        { 0xffffffffffffffc0ull, 0x000000000fffffffull },
+        { 0xffffffffffffffe0ull, 0x0000000007ffffffull },
+        { 0xfffffffffffffff0ull, 0x0000000003ffffffull },
+        { 0xfffffffffffffff8ull, 0x0000000007ffffffull },
+        { 0xfffffffffffffff8ull, 0x0000000007ffffffull },
+        { 0xfffffffffffffff8ull, 0x000000000fffffffull },
+        { 0xfffffffffffffe00ull, 0x000000000e1fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff00ull, 0x00000000003fffffull },
+        { 0xffffffffffffff00ull, 0x00000000003fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000003fffffull },
+        { 0xffffffffffffff00ull, 0x00000000003fffffull },
+        { 0xffffffffffffff00ull, 0x00000000003fffffull },
+        { 0xffffffffffffff00ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff80ull, 0x00000000003fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xffffffffffffff00ull, 0x00000000001fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000000fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000000fffffull },
+        { 0xfffffffffffffe00ull, 0x00000000000fffffull },
+        { 0xfffffffffffffc00ull, 0x000000000007ffffull },
+        { 0xfffffffffffffc00ull, 0x000000000007ffffull },
+        { 0xfffffffffffffc00ull, 0x000000000007ffffull },
+        { 0xfffffffffffffc00ull, 0x000000000007ffffull },
+        { 0xfffffffffffffc00ull, 0x000000000003ffffull },
+        { 0xfffffffffffff800ull, 0x000000000003ffffull },
+        { 0xfffffffffffff800ull, 0x000000000003ffffull },
+        { 0xfffffffffffff800ull, 0x000000000003ffffull },
+        { 0xfffffffffffff000ull, 0x000000000003ffffull },
+        { 0xfffffffffffff000ull, 0x000000000003ffffull },
+        { 0xffffffffffffe000ull, 0x000000000003ffffull },
+        { 0xffffffffffffc000ull, 0x000000000003ffffull },
+        { 0xffffffffffff8000ull, 0x000000000003ffffull },
+        { 0xffffffffffff0000ull, 0x000000000003ffffull },
+        { 0xfffffffffffe0000ull, 0x000000000003ffffull },
+        { 0xfffffffffff80000ull, 0x000000000003ffffull },
+        { 0xffffffffffe00000ull, 0x000000000003ffffull },
+        { 0xffffffffff000000ull, 0x000000000003ffffull },
+        { 0xffffffffe0000000ull, 0x000000000003ffffull },
+        { 0xff80000000000000ull, 0x000000000003ffffull },
+        { 0xfe00000000000000ull, 0x000000000003ffffull },
+        { 0xfe00000000000000ull, 0x000000000003ffffull },
+        { 0xfc00000000000000ull, 0x000000000003ffffull },
+        { 0xfc00000000000000ull, 0x000000000001ffffull },
+        { 0xfc00000000000000ull, 0x000000000001ffffull },
+        { 0xfc00000000000000ull, 0x000000000000ffffull },
+        { 0xfc00000000000000ull, 0x000000000000ffc3ull },
+        { 0xf800000000000000ull, 0x000000000000ff80ull },
+        { 0x0000000000000000ull, 0x0000000000007f00ull },
+        { 0x0000000000000000ull, 0x0000000000007e00ull },
+        { 0x0000000000000000ull, 0x0000000000007e00ull },
+        { 0x0000000000000000ull, 0x0000000000003c00ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+        { 0x0000000000000000ull, 0x0000000000000000ull },
+    } },
+};
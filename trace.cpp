@@ -0,0 +1,196 @@
+#include "trace.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+// ===========================
+// Trace Implementation
+// ===========================
+
+namespace Trace {
+
+std::atomic<bool> recording{false};
+
+namespace {
+
+static_assert((TRACE_CAPACITY & (TRACE_CAPACITY - 1)) == 0, "TRACE_CAPACITY must be a power of two");
+
+struct Event {
+    std::atomic<quint64> sequence{0}; // Slot index + 1 once the event is complete, 0 while being written
+    qint64 start;
+    qint64 duration;
+    const char* category;
+    const char* name;
+};
+
+// Events of one thread; only that thread writes, write() reads concurrently.
+// Buffers are never freed. When their thread exits they are handed to the
+// next new thread with the same name, which continues on the same row of
+// the timeline, so threads that are recreated (the composer worker) do not
+// use up buffers and threads of different roles keep separate rows.
+struct ThreadBuffer {
+    int id; // Thread id in the trace
+    bool inUse; // Owned by a running thread; guarded by registerMutex
+    std::atomic<const char*> name{nullptr};
+    std::atomic<quint64> head{0};
+    Event events[TRACE_CAPACITY];
+};
+
+ThreadBuffer* buffers[TRACE_MAX_THREADS];
+std::atomic<int> bufferCount{0};
+std::mutex registerMutex;
+const qint64 origin = PerfStats::now(); // Trace timestamps count from here
+
+// Releases the thread's buffer when the thread exits
+struct BufferOwner {
+    ThreadBuffer* buffer = nullptr;
+    bool dropped = false; // Set once the thread found every buffer taken
+
+    ~BufferOwner() {
+        if (buffer) {
+            std::lock_guard<std::mutex> locker(registerMutex);
+            buffer->inUse = false;
+        }
+    }
+};
+
+thread_local BufferOwner localOwner;
+thread_local const char* localName = nullptr;
+
+// Returns true if two thread names, either of which may be unset, are equal
+bool sameName(const char* a, const char* b) {
+    return a == b || (a && b && std::strcmp(a, b) == 0);
+}
+
+// Returns the calling thread's buffer, taking a released one of a thread
+// with the same name or allocating one on the thread's first event, or
+// nullptr if all TRACE_MAX_THREADS buffers are taken
+ThreadBuffer* threadBuffer() {
+    if (localOwner.buffer || localOwner.dropped) {
+        return localOwner.buffer;
+    }
+    std::lock_guard<std::mutex> locker(registerMutex);
+    const int count = bufferCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i) {
+        if (!buffers[i]->inUse && sameName(buffers[i]->name.load(std::memory_order_relaxed), localName)) {
+            localOwner.buffer = buffers[i];
+            break;
+        }
+    }
+    if (!localOwner.buffer) {
+        if (count == TRACE_MAX_THREADS) {
+            localOwner.dropped = true;
+            return nullptr;
+        }
+        localOwner.buffer = new ThreadBuffer;
+        localOwner.buffer->id = count + 1;
+        buffers[count] = localOwner.buffer;
+        bufferCount.store(count + 1, std::memory_order_release);
+    }
+    localOwner.buffer->inUse = true;
+    localOwner.buffer->name.store(localName, std::memory_order_relaxed);
+    return localOwner.buffer;
+}
+
+} // namespace
+
+// Starts or stops recording; buffered events are kept either way
+void setEnabled(bool enabled) {
+    recording.store(enabled, std::memory_order_relaxed);
+}
+
+// Names the calling thread; takes effect in its buffer now or when it is allocated
+void setThreadName(const char* name) {
+    localName = name;
+    if (localOwner.buffer) {
+        localOwner.buffer->name.store(name, std::memory_order_relaxed);
+    }
+}
+
+// Claims the next slot of the calling thread's ring and fills it, if tracing is on
+void record(const char* category, const char* name, qint64 start, qint64 end) {
+    if (!isEnabled()) {
+        return;
+    }
+    ThreadBuffer* buffer = threadBuffer();
+    if (!buffer) {
+        return;
+    }
+    const quint64 slot = buffer->head.load(std::memory_order_relaxed);
+    Event& event = buffer->events[slot & (TRACE_CAPACITY - 1)];
+    event.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    event.start = start;
+    event.duration = end - start;
+    event.category = category;
+    event.name = name;
+    event.sequence.store(slot + 1, std::memory_order_release);
+    buffer->head.store(slot + 1, std::memory_order_release);
+}
+
+// Writes thread names as metadata events, then each thread's events oldest
+// first as complete ("X") events with microsecond timestamps. Events that
+// are overwritten while being read are skipped.
+bool write(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Failed to write trace to" << path;
+        return false;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    const int threads = bufferCount.load(std::memory_order_acquire);
+    char line[256];
+    qint64 written = 0;
+    std::snprintf(line, sizeof(line),
+                  "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+                  "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%lld,\"args\":{\"name\":\"GameQT\"}}",
+                  static_cast<long long>(pid));
+    file.write(line);
+    for (int i = 0; i < threads; ++i) {
+        const ThreadBuffer& buffer = *buffers[i];
+        char unnamed[16];
+        std::snprintf(unnamed, sizeof(unnamed), "thread %d", buffer.id);
+        const char* name = buffer.name.load(std::memory_order_relaxed);
+        std::snprintf(line, sizeof(line),
+                      ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%lld,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                      static_cast<long long>(pid), buffer.id, name ? name : unnamed);
+        file.write(line);
+    }
+
+    for (int i = 0; i < threads; ++i) {
+        const ThreadBuffer& buffer = *buffers[i];
+        const quint64 end = buffer.head.load(std::memory_order_acquire);
+        const quint64 begin = end > TRACE_CAPACITY ? end - TRACE_CAPACITY : 0;
+        for (quint64 slot = begin; slot < end; ++slot) {
+            const Event& event = buffer.events[slot & (TRACE_CAPACITY - 1)];
+            if (event.sequence.load(std::memory_order_acquire) != slot + 1) {
+                continue;
+            }
+            const qint64 start = event.start;
+            const qint64 duration = event.duration;
+            const char* category = event.category;
+            const char* name = event.name;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (event.sequence.load(std::memory_order_relaxed) != slot + 1) {
+                continue;
+            }
+            std::snprintf(line, sizeof(line),
+                          ",\n{\"ph\":\"X\",\"cat\":\"%s\",\"name\":\"%s\",\"pid\":%lld,\"tid\":%d,"
+                          "\"ts\":%.3f,\"dur\":%.3f}",
+                          category, name, static_cast<long long>(pid), buffer.id, (start - origin) / 1e3,
+                          duration / 1e3);
+            file.write(line);
+            ++written;
+        }
+    }
+    file.write("\n]}\n");
+    qInfo("Trace of %lld events on %d threads written to %s", static_cast<long long>(written), threads,
+          qPrintable(path));
+    return true;
+}
+
+} // namespace Trace
@@ -0,0 +1,69 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include "perfstats.h"
+
+// Timeline of where frames spend their time, for chrome://tracing and
+// ui.perfetto.dev.
+//
+// TRACE_SCOPE marks a block as one complete event. While tracing is off a
+// scope costs one relaxed atomic load; while it is on, two clock reads and a
+// store into a ring buffer owned by the recording thread, so threads never
+// contend and recording never locks. A thread's buffer is allocated on its
+// first event; after that recording never allocates. Each thread keeps its
+// latest TRACE_CAPACITY events.
+//
+// Category and event names must be string literals without characters that
+// need escaping in JSON, because only their pointers are stored.
+
+#define TRACE_CAPACITY 16384 // Events kept per thread (power of two); older ones are overwritten
+#define TRACE_MAX_THREADS 32 // Threads that can record; events of any further thread are dropped
+
+namespace Trace {
+
+extern std::atomic<bool> recording;
+
+void setEnabled(bool enabled);
+inline bool isEnabled() { return recording.load(std::memory_order_relaxed); }
+
+// Names the calling thread in the trace; name must be a string literal
+void setThreadName(const char* name);
+
+// Adds one complete event from start to end on the PerfStats::now() clock;
+// for phases that are timed already. Does nothing while tracing is off.
+void record(const char* category, const char* name, qint64 start, qint64 end);
+
+// Writes every thread's buffered events as Chrome trace-event JSON.
+// Recording may continue on other threads while this runs.
+bool write(const QString& path);
+
+} // namespace Trace
+
+// Records the lifetime of the scope as one event if tracing was on when it began
+class TraceScope
+{
+public:
+    TraceScope(const char* category, const char* name)
+        : category(category), name(name), start(Trace::isEnabled() ? PerfStats::now() : 0) {}
+    ~TraceScope() {
+        if (start != 0) {
+            Trace::record(category, name, start, PerfStats::now());
+        }
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* category;
+    const char* name;
+    qint64 start; // 0 if tracing was off
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(category, name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(category, name)
+
+#endif // TRACE_H
@@ -0,0 +1,128 @@
+#include "traffic.h"
+#include <QtGlobal>
+
+// ===========================
+// Traffic Class Implementation
+// ===========================
+
+// Constructor creates an empty road with the given number of lanes
+Traffic::Traffic(int laneCount) : laneCount(qBound(1, laneCount, MAX_LANE_COUNT)), maxSpeed(0.0f) {}
+
+// Removes every car
+void Traffic::clear() {
+    x.clear();
+    y.clear();
+    previousY.clear();
+    speed.clear();
+    lane.clear();
+    sprite.clear();
+    maxSpeed = 0.0f;
+}
+
+// Reserves room for count cars so add() does not reallocate
+void Traffic::reserve(int count) {
+    x.reserve(count);
+    y.reserve(count);
+    previousY.reserve(count);
+    speed.reserve(count);
+    lane.reserve(count);
+    sprite.reserve(count);
+}
+
+// Changes the number of lanes; existing cars are removed
+void Traffic::setLaneCount(int count) {
+    laneCount = qBound(1, count, MAX_LANE_COUNT);
+    clear();
+}
+
+// Returns the number of lanes
+int Traffic::getLaneCount() const {
+    return laneCount;
+}
+
+// Returns the X position that centers a car in the given lane
+int Traffic::laneToX(int lane, int laneCount) {
+    int laneWidth = WINDOWS_SIZE_X / laneCount;
+    return lane * laneWidth + (laneWidth - CAR_SIZE_X) / 2;
+}
+
+// Adds a car and returns its index
+int Traffic::add(int carLane, float carY, float carSpeed, SpriteId carSprite) {
+    x.push_back(laneToX(carLane, laneCount));
+    y.push_back(carY);
+    previousY.push_back(carY);
+    speed.push_back(carSpeed);
+    maxSpeed = qMax(maxSpeed, carSpeed);
+    lane.push_back(carLane);
+    sprite.push_back(carSprite);
+    return static_cast<int>(y.size()) - 1;
+}
+
+// Returns the number of cars
+int Traffic::size() const {
+    return static_cast<int>(y.size());
+}
+
+// Moves every car down by distance times its speed multiplier
+void Traffic::advance(float distance) {
+    const int count = size();
+    float* __restrict ys = y.data();
+    float* __restrict previous = previousY.data();
+    const float* __restrict speeds = speed.data();
+    for (int i = 0; i < count; ++i) {
+        previous[i] = ys[i];
+        ys[i] += distance * speeds[i];
+    }
+}
+
+// Moves a car to a new Y (a teleport, so nothing is interpolated)
+void Traffic::setY(int index, float carY) {
+    y[index] = carY;
+    previousY[index] = carY;
+}
+
+// Sets a car's position together with its position before the last step
+void Traffic::setY(int index, float carY, float carPreviousY) {
+    y[index] = carY;
+    previousY[index] = carPreviousY;
+}
+
+// Returns a car's X position
+int Traffic::getX(int index) const {
+    return x[index];
+}
+
+// Returns a car's Y position
+float Traffic::getY(int index) const {
+    return y[index];
+}
+
+// Returns a car's Y before the last advance()
+float Traffic::getPreviousY(int index) const {
+    return previousY[index];
+}
+
+// Returns a car's Y blended between the previous and current step (alpha in [0, 1])
+float Traffic::getRenderY(int index, float alpha) const {
+    return previousY[index] + (y[index] - previousY[index]) * alpha;
+}
+
+// Returns a car's lane index
+int Traffic::getLane(int index) const {
+    return lane[index];
+}
+
+// Returns a car's speed multiplier
+float Traffic::getSpeed(int index) const {
+    return speed[index];
+}
+
+// Returns the largest speed multiplier of any car, or 0 without cars
+float Traffic::getMaxSpeed() const {
+    return maxSpeed;
+}
+
+// Returns a car's sprite
+SpriteId Traffic::getSprite(int index) const {
+    return sprite[index];
+}
@@ -0,0 +1,52 @@
+#ifndef TRAFFIC_H
+#define TRAFFIC_H
+
+#include <vector>
+#include "shared.h"
+#include "car.h"
+
+#define DEFAULT_LANE_COUNT 3
+#define DEFAULT_TRAFFIC_COUNT 3
+#define MAX_LANE_COUNT 32 // Lane occupancy is tracked in a 32-bit mask
+
+// Structure-of-arrays store for traffic cars. Each column holds one property
+// for every car, so per-tick updates run as flat loops the compiler can
+// vectorize. Lanes are equal-width strips across the road; any number of
+// lanes and cars is supported.
+class Traffic
+{
+public:
+    explicit Traffic(int laneCount = DEFAULT_LANE_COUNT);
+    void clear();
+    void reserve(int count);
+    void setLaneCount(int count);
+    int getLaneCount() const;
+    static int laneToX(int lane, int laneCount);
+
+    int add(int lane, float y, float speed = 1.0f, SpriteId sprite = SpriteId::Traffic);
+    int size() const;
+    void advance(float distance);
+    void setY(int index, float y);
+    void setY(int index, float y, float previousY);
+
+    int getX(int index) const;
+    float getY(int index) const;
+    float getPreviousY(int index) const;
+    float getRenderY(int index, float alpha) const;
+    int getLane(int index) const;
+    float getSpeed(int index) const;
+    float getMaxSpeed() const;
+    SpriteId getSprite(int index) const;
+
+private:
+    int laneCount;
+    std::vector<int> x;
+    std::vector<float> y;
+    std::vector<float> previousY; // Y before the last advance(), used for interpolation
+    std::vector<float> speed; // Multiplier applied to the road speed
+    float maxSpeed; // Largest speed multiplier, bounds how far any car moves in a step
+    std::vector<int> lane;
+    std::vector<SpriteId> sprite;
+};
+
+#endif // TRAFFIC_H